@@ -4,103 +4,109 @@
 // without changing algorithm logic (satisfies Part 1 modularity requirement)
 
 #include "graph.h"
+#include "search_engine.h"
+#include "search_workspace.h"
 #include <vector>
+#include <utility>
 #include <limits>
 
-struct DijkstraResult {
-    std::vector<double> dist;
-    std::vector<int> parent;
+template<typename Key = double, typename Vertex = int>
+struct BasicDijkstraResult {
+    std::vector<Key> dist;
+    std::vector<Vertex> parent;
 };
 
-struct PrimResult {
-    double total_weight;
-    std::vector<int> parent;
+template<typename Vertex = int>
+struct BasicPrimResult {
+    double total_weight; // accumulated in double even for narrow key types
+    std::vector<Vertex> parent;
 };
 
-// Dijkstra's single-source shortest path (non-negative weights)
-// Heap type must support: insert(vertex, priority), extract_min(), decrease_key(handle, key), empty()
-template<typename Heap>
-DijkstraResult dijkstra(const Graph& g, int source) {
-    int n = g.size();
-    const double INF = std::numeric_limits<double>::infinity();
-
-    DijkstraResult result;
-    result.dist.assign(n, INF);
-    result.parent.assign(n, -1);
+using DijkstraResult = BasicDijkstraResult<>;
+using PrimResult = BasicPrimResult<>;
 
-    std::vector<typename Heap::Handle*> handles(n, nullptr);
-    std::vector<bool> visited(n, false);
+template<typename Heap>
+using DijkstraResultFor = BasicDijkstraResult<typename Heap::Key, typename Heap::Vertex>;
+template<typename Heap>
+using PrimResultFor = BasicPrimResult<typename Heap::Vertex>;
+
+// All entry points below are thin wrappers over the loops in search_engine.h.
+// The Visitor overloads are what the benchmark harness calls; the plain ones
+// pass NullSearchVisitor, whose hooks compile away. The graph type is deduced;
+// its Weight / Vertex types must match the heap's Key / Vertex types.
+
+// Dijkstra's single-source shortest path (non-negative weights) on a caller-owned heap
+// Heap type must support: insert(vertex, priority), build(items), extract_min(),
+//                         decrease_key(handle, key), empty(), size()
+template<typename Heap, typename Visitor, typename G>
+DijkstraResultFor<Heap> dijkstra(const G& g, typename G::Vertex source, InsertMode mode,
+                                 Heap& heap, Visitor& vis) {
+    DenseLabels<typename Heap::Handle, typename Heap::Key, typename Heap::Vertex> labels(g.size());
+    dijkstra_search(g, source, mode, heap, labels, vis);
+    return {labels.take_dist(), labels.take_parent()};
+}
 
+template<typename Heap, typename G>
+DijkstraResultFor<Heap> dijkstra(const G& g, typename G::Vertex source,
+                                 InsertMode mode = InsertMode::Eager) {
     Heap heap;
-    result.dist[source] = 0.0;
-    handles[source] = heap.insert(source, 0.0);
-
-    for (int v = 0; v < n; v++) {
-        if (v != source)
-            handles[v] = heap.insert(v, INF);
-    }
-
-    while (!heap.empty()) {
-        auto [u, d] = heap.extract_min();
-        visited[u] = true;
-
-        if (d == INF) break; // remaining vertices unreachable
-
-        for (const auto& edge : g.adj[u]) {
-            int v = edge.to;
-            if (!visited[v]) {
-                double new_dist = result.dist[u] + edge.weight;
-                if (new_dist < result.dist[v]) {
-                    result.dist[v] = new_dist;
-                    result.parent[v] = u;
-                    heap.decrease_key(handles[v], new_dist);
-                }
-            }
-        }
-    }
-
-    return result;
+    NullSearchVisitor vis;
+    return dijkstra(g, source, mode, heap, vis);
 }
 
-// Prim's Minimum Spanning Tree algorithm
-// Heap type must support: insert(vertex, priority), extract_min(), decrease_key(handle, key), empty()
-template<typename Heap>
-PrimResult prim(const Graph& g) {
-    int n = g.size();
-    const double INF = std::numeric_limits<double>::infinity();
-
-    PrimResult result;
-    result.total_weight = 0.0;
-    result.parent.assign(n, -1);
-
-    std::vector<double> key(n, INF);
-    std::vector<typename Heap::Handle*> handles(n, nullptr);
-    std::vector<bool> in_mst(n, false);
+// Prim's Minimum Spanning Tree algorithm (grown from vertex 0) on a caller-owned heap
+// Heap type must support: insert(vertex, priority), build(items), extract_min(),
+//                         decrease_key(handle, key), empty(), size()
+template<typename Heap, typename Visitor, typename G>
+PrimResultFor<Heap> prim(const G& g, InsertMode mode, Heap& heap, Visitor& vis) {
+    DenseLabels<typename Heap::Handle, typename Heap::Key, typename Heap::Vertex> labels(g.size());
+    double total_weight = prim_search(g, typename G::Vertex(0), mode, heap, labels, vis);
+    return {total_weight, labels.take_parent()};
+}
 
+template<typename Heap, typename G>
+PrimResultFor<Heap> prim(const G& g, InsertMode mode = InsertMode::Eager) {
     Heap heap;
-    key[0] = 0.0;
-    handles[0] = heap.insert(0, 0.0);
-
-    for (int v = 1; v < n; v++) {
-        handles[v] = heap.insert(v, INF);
-    }
+    NullSearchVisitor vis;
+    return prim(g, mode, heap, vis);
+}
 
-    while (!heap.empty()) {
-        auto [u, d] = heap.extract_min();
-        in_mst[u] = true;
+// Dijkstra against a reusable workspace: the workspace is reset (O(1)) and
+// vertices are inserted lazily on discovery, so a query only touches the
+// part of the graph it reaches. Results are read back via ws.dist(v) /
+// ws.parent(v), and ws.touched() lists the reached vertices.
+template<typename Heap, typename G>
+void dijkstra(const G& g, typename G::Vertex source, SearchWorkspace<Heap>& ws) {
+    ws.reset();
+    NullSearchVisitor vis;
+    dijkstra_search(g, source, InsertMode::Lazy, ws.heap(), ws, vis);
+}
 
-        if (d == INF) break; // remaining vertices not reachable
-        result.total_weight += d;
+// Prim against a reusable workspace (lazy insertion, grown from vertex 0);
+// ws.dist(v) holds the connecting edge weight and ws.parent(v) the MST parent.
+// Returns the total weight of the spanning tree of 0's component.
+template<typename Heap, typename G>
+double prim(const G& g, SearchWorkspace<Heap>& ws) {
+    ws.reset();
+    NullSearchVisitor vis;
+    return prim_search(g, typename G::Vertex(0), InsertMode::Lazy, ws.heap(), ws, vis);
+}
 
-        for (const auto& edge : g.adj[u]) {
-            int v = edge.to;
-            if (!in_mst[v] && edge.weight < key[v]) {
-                key[v] = edge.weight;
-                result.parent[v] = u;
-                heap.decrease_key(handles[v], edge.weight);
-            }
-        }
-    }
+// Lazy-deletion Dijkstra: no handles or decrease-key. A vertex is inserted again
+// whenever its distance improves and stale entries are skipped on extraction,
+// so the queue may hold up to E entries.
+// Queue type must support: insert(vertex, priority), extract_min(), empty(), size()
+template<typename Queue, typename Visitor, typename G>
+DijkstraResultFor<Queue> dijkstra_lazy(const G& g, typename G::Vertex source,
+                                       Queue& queue, Visitor& vis) {
+    DenseLabels<void, typename Queue::Key, typename Queue::Vertex> labels(g.size());
+    dijkstra_lazy_search(g, source, queue, labels, vis);
+    return {labels.take_dist(), labels.take_parent()};
+}
 
-    return result;
+template<typename Queue, typename G>
+DijkstraResultFor<Queue> dijkstra_lazy(const G& g, typename G::Vertex source) {
+    Queue queue;
+    NullSearchVisitor vis;
+    return dijkstra_lazy(g, source, queue, vis);
 }
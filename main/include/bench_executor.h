@@ -0,0 +1,302 @@
+#pragma once
+// Parallel execution of independent benchmark cells
+// A cell is one (graph, algorithm, heap) run returning a BenchmarkResult.
+// The executor runs up to `jobs` cells at a time, either on worker threads or
+// in forked child processes, and returns the results in submission order
+// (they are also appended to Benchmark::results in that order, so reports and
+// verification look the same as a serial run).
+//   Isolation::Threads   - shared address space; cheapest to start
+//   Isolation::Processes - each cell in its own process (separate allocator
+//                          state; a crashing cell is reported, not fatal)
+// Workers can be pinned to CPUs on Linux. one_per_core restricts the run to one
+// logical CPU per physical core (no two cells share a core's caches and
+// execution units), capping concurrency at the physical core count.
+
+#include "benchmark.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+#include <cstdlib>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+enum class Isolation { Threads, Processes };
+
+struct ExecutorOptions {
+    int jobs = 1;              // concurrent cells; 0 = one per available CPU (or core)
+    Isolation isolation = Isolation::Threads;
+    bool one_per_core = false; // at most one cell per physical core
+    bool pin = false;          // pin each worker to its own CPU (Linux only; implied by one_per_core)
+};
+
+namespace cpu_topology {
+
+// Logical CPUs this process may run on
+inline std::vector<int> usable_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned c = 0; c < n; c++) cpus.push_back(static_cast<int>(c));
+    }
+    return cpus;
+}
+
+// The first usable logical CPU of every physical core (SMT siblings dropped),
+// from sysfs (package id, core id); falls back to all usable CPUs
+inline std::vector<int> one_cpu_per_core() {
+    std::vector<int> cpus;
+    std::set<std::pair<int, int>> seen;
+    for (int c : usable_cpus()) {
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(c) + "/topology/";
+        std::ifstream core_file(base + "core_id"), package_file(base + "physical_package_id");
+        int core = -1, package = -1;
+        if (!(core_file >> core) || !(package_file >> package)) return usable_cpus();
+        if (seen.insert({package, core}).second) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+inline bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace cpu_topology
+
+class BenchmarkExecutor {
+public:
+    explicit BenchmarkExecutor(ExecutorOptions opts = ExecutorOptions())
+        : options(opts),
+          cpus(opts.one_per_core ? cpu_topology::one_cpu_per_core() : cpu_topology::usable_cpus()) {
+        int available = static_cast<int>(cpus.size());
+        num_workers = options.jobs > 0 ? options.jobs : available;
+        if (options.one_per_core) num_workers = std::min(num_workers, available);
+        num_workers = std::max(num_workers, 1);
+#if !defined(__linux__)
+        options.isolation = Isolation::Threads; // no fork()
+#endif
+    }
+
+    // Queue a cell; returns its index in the result vector
+    std::size_t add(std::function<BenchmarkResult()> cell) {
+        cells.push_back(std::move(cell));
+        return cells.size() - 1;
+    }
+
+    std::size_t size() const { return cells.size(); }
+    int workers() const { return num_workers; }
+    bool pinned() const { return options.pin || options.one_per_core; }
+    const ExecutorOptions& settings() const { return options; }
+
+    // Run every queued cell and clear the queue
+    std::vector<BenchmarkResult> run() {
+        std::size_t first_row = Benchmark::result_count();
+        std::vector<BenchmarkResult> out(cells.size());
+        if (options.isolation == Isolation::Processes)
+            run_processes(out);
+        else
+            run_threads(out);
+        cells.clear();
+
+        Benchmark::replace_results_since(first_row, out);
+        return out;
+    }
+
+    // Placeholder row for a cell that threw or whose process died
+    static BenchmarkResult failed_result(const std::string& reason) {
+        BenchmarkResult res{};
+        res.algorithm = "FAILED";
+        res.heap_type = reason;
+        res.graph_type = "-";
+        res.insert_mode = "-";
+        res.result_value = std::numeric_limits<double>::quiet_NaN();
+        return res;
+    }
+
+private:
+    ExecutorOptions options;
+    std::vector<int> cpus;
+    int num_workers;
+    std::vector<std::function<BenchmarkResult()>> cells;
+
+    BenchmarkResult run_cell(std::size_t i) {
+        try {
+            return cells[i]();
+        } catch (const std::exception& e) {
+            return failed_result(e.what());
+        }
+    }
+
+    // Worker w takes cells from a shared counter; pinned to cpus[w]
+    void run_threads(std::vector<BenchmarkResult>& out) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&](int w) {
+            if (pinned()) cpu_topology::pin_current_thread(cpus[w % cpus.size()]);
+            for (std::size_t i = next++; i < cells.size(); i = next++)
+                out[i] = run_cell(i);
+        };
+
+        if (num_workers == 1 && !pinned()) {
+            worker(0);
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (int w = 0; w < num_workers; w++) pool.emplace_back(worker, w);
+        for (auto& t : pool) t.join();
+    }
+
+#if defined(__linux__)
+    // One child per cell, at most num_workers alive; each writes its result
+    // to a pipe and exits. Results are small, so the pipe never fills.
+    void run_processes(std::vector<BenchmarkResult>& out) {
+        struct Child {
+            pid_t pid;
+            int fd;
+            std::size_t cell;
+            int worker;
+        };
+        std::vector<Child> running;
+        std::vector<bool> worker_busy(static_cast<std::size_t>(num_workers), false);
+        std::size_t next = 0;
+
+        std::cout.flush(); // children must not inherit unflushed output
+        while (next < cells.size() || !running.empty()) {
+            while (next < cells.size() && static_cast<int>(running.size()) < num_workers) {
+                int w = static_cast<int>(std::find(worker_busy.begin(), worker_busy.end(), false) -
+                                         worker_busy.begin());
+                int fds[2];
+                if (pipe(fds) != 0) {
+                    out[next] = failed_result("pipe() failed");
+                    next++;
+                    continue;
+                }
+                pid_t pid = fork();
+                if (pid == 0) {
+                    close(fds[0]);
+                    if (pinned()) cpu_topology::pin_current_thread(cpus[w % cpus.size()]);
+                    std::string data = serialize(run_cell(next));
+                    std::size_t written = 0;
+                    while (written < data.size()) {
+                        ssize_t k = write(fds[1], data.data() + written, data.size() - written);
+                        if (k <= 0) _exit(2);
+                        written += static_cast<std::size_t>(k);
+                    }
+                    close(fds[1]);
+                    _exit(0);
+                }
+                close(fds[1]);
+                if (pid < 0) {
+                    close(fds[0]);
+                    out[next] = failed_result("fork() failed");
+                    next++;
+                    continue;
+                }
+                worker_busy[w] = true;
+                running.push_back({pid, fds[0], next, w});
+                next++;
+            }
+            if (running.empty()) continue;
+
+            int status = 0;
+            pid_t done = waitpid(-1, &status, 0);
+            if (done < 0) break;
+            auto it = std::find_if(running.begin(), running.end(),
+                                   [&](const Child& c) { return c.pid == done; });
+            if (it == running.end()) continue;
+
+            std::string data;
+            char buf[4096];
+            ssize_t k;
+            while ((k = read(it->fd, buf, sizeof(buf))) > 0) data.append(buf, static_cast<std::size_t>(k));
+            close(it->fd);
+
+            BenchmarkResult res;
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && deserialize(data, res))
+                out[it->cell] = res;
+            else if (WIFSIGNALED(status))
+                out[it->cell] = failed_result("signal " + std::to_string(WTERMSIG(status)));
+            else
+                out[it->cell] = failed_result("exit " + std::to_string(WEXITSTATUS(status)));
+            worker_busy[it->worker] = false;
+            running.erase(it);
+        }
+    }
+#else
+    void run_processes(std::vector<BenchmarkResult>& out) { run_threads(out); }
+#endif
+
+    // One field per line (strings never contain newlines)
+    static std::string serialize(const BenchmarkResult& r) {
+        std::ostringstream os;
+        os.precision(17);
+        os << r.algorithm << '\n' << r.heap_type << '\n' << r.graph_type << '\n'
+           << r.num_vertices << '\n' << r.num_edges << '\n' << r.insert_mode << '\n'
+           << r.total_time_ms << '\n' << r.init_time_ms << '\n'
+           << r.insert_ops << '\n' << r.extract_min_ops << '\n' << r.decrease_key_ops << '\n'
+           << r.extract_min_time_ms << '\n' << r.decrease_key_time_ms << '\n'
+           << r.peak_heap_size << '\n' << r.result_value << '\n';
+        for (const LatencySummary* l : {&r.extract_min_latency, &r.decrease_key_latency})
+            os << l->samples << '\n' << l->p50 << '\n' << l->p99 << '\n' << l->p999 << '\n'
+               << l->max << '\n';
+        return os.str();
+    }
+
+    static bool deserialize(const std::string& data, BenchmarkResult& r) {
+        std::istringstream is(data);
+        auto line = [&](std::string& s) { return static_cast<bool>(std::getline(is, s)); };
+        auto value = [&](auto& v) {
+            std::string s;
+            if (!line(s)) return false;
+            if constexpr (std::is_floating_point<std::decay_t<decltype(v)>>::value) {
+                char* end = nullptr; // strtod, unlike >>, accepts "nan" / "inf"
+                v = std::strtod(s.c_str(), &end);
+                return end != s.c_str();
+            } else {
+                std::istringstream field(s);
+                return static_cast<bool>(field >> v);
+            }
+        };
+        auto latency = [&](LatencySummary& l) {
+            return value(l.samples) && value(l.p50) && value(l.p99) && value(l.p999) && value(l.max);
+        };
+        return line(r.algorithm) && line(r.heap_type) && line(r.graph_type) &&
+               value(r.num_vertices) && value(r.num_edges) && line(r.insert_mode) &&
+               value(r.total_time_ms) && value(r.init_time_ms) &&
+               value(r.insert_ops) && value(r.extract_min_ops) && value(r.decrease_key_ops) &&
+               value(r.extract_min_time_ms) && value(r.decrease_key_time_ms) &&
+               value(r.peak_heap_size) && value(r.result_value) &&
+               latency(r.extract_min_latency) && latency(r.decrease_key_latency);
+    }
+};
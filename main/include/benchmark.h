@@ -1,12 +1,17 @@
 #pragma once
 // Benchmarking framework for comparative analysis of priority queues
 // Collects: total runtime, time in extract-min and decrease-key,
+//           per-operation latency percentiles (latency_histogram.h),
 //           number of heap operations, and result values for verification
 
 #include "graph.h"
+#include "algorithms.h"
 #include "fibonacci_heap.h"
 #include "pairing_heap.h"
 #include "binary_heap.h"
+#include "dense_search.h"
+#include "trace.h"
+#include "latency_histogram.h"
 
 #include <iostream>
 #include <iomanip>
@@ -15,146 +20,266 @@
 #include <vector>
 #include <limits>
 #include <cmath>
+#include <random>
+#include <algorithm>
+#include <mutex>
 
 struct BenchmarkResult {
     std::string algorithm;
     std::string heap_type;
     std::string graph_type;
-    int num_vertices;
-    int num_edges;
+    long long num_vertices;
+    std::uint64_t num_edges;
+    std::string insert_mode; // "eager" (all vertices up front) or "lazy" (on discovery)
     double total_time_ms;
+    double init_time_ms;     // heap population phase (build or first insert)
     int insert_ops;
     int extract_min_ops;
     int decrease_key_ops;
     double extract_min_time_ms;
     double decrease_key_time_ms;
+    std::size_t peak_heap_size;
     double result_value; // sum of shortest distances (Dijkstra) or MST weight (Prim)
+    LatencySummary extract_min_latency;  // empty for heap-free runs
+    LatencySummary decrease_key_latency;
+};
+
+// Search hooks used by the harness: times the initialization phase (heap
+// population) separately from the main loop and tracks the peak heap size.
+// Both phases also go to the trace timeline when tracing is on.
+struct BenchmarkVisitor {
+    using clock = std::chrono::high_resolution_clock;
+
+    double init_time_ms = 0;
+    std::size_t peak_heap_size = 0;
+
+    void on_init_begin() { init_start = clock::now(); }
+    void on_init_end(std::size_t heap_size) {
+        loop_start = clock::now();
+        init_time_ms = std::chrono::duration<double, std::milli>(loop_start - init_start).count();
+        peak_heap_size = heap_size;
+        trace::complete("heap build", "search", init_start, loop_start);
+    }
+    void on_insert(std::size_t heap_size) { peak_heap_size = std::max(peak_heap_size, heap_size); }
+    template<typename Vertex, typename Key>
+    void on_settle(Vertex, Key) {}
+    template<typename Vertex, typename Key>
+    void on_improve(Vertex, Key, Vertex) {}
+    void on_search_end() { trace::complete("search loop", "search", loop_start, clock::now()); }
+
+private:
+    clock::time_point init_start, loop_start;
 };
 
 class Benchmark {
 public:
     static std::vector<BenchmarkResult> results;
+    static std::mutex results_mutex;
 
-    template<typename Heap>
-    static BenchmarkResult run_dijkstra(const Graph& g, const std::string& graph_type) {
-        int n = g.size();
-        const double INF = std::numeric_limits<double>::infinity();
-
-        std::vector<double> dist(n, INF);
-        std::vector<int> parent(n, -1);
-        std::vector<typename Heap::Handle*> handles(n, nullptr);
-        std::vector<bool> visited(n, false);
+    // Each run calls the same algorithms.h entry point as production code,
+    // with BenchmarkVisitor plugged into the engine's hooks. Any graph type
+    // works as long as its weight / id types match the heap's.
 
+    template<typename Heap, typename G>
+    static BenchmarkResult run_dijkstra(const G& g, const std::string& graph_type,
+                                        InsertMode mode = InsertMode::Eager) {
+        trace::Zone zone(std::string("Dijkstra ") + Heap::name() + " " + graph_type, "benchmark");
         Heap heap;
+        BenchmarkVisitor vis;
 
         auto start = std::chrono::high_resolution_clock::now();
+        auto result = dijkstra(g, typename G::Vertex(0), mode, heap, vis);
+        auto end = std::chrono::high_resolution_clock::now();
 
-        dist[0] = 0.0;
-        handles[0] = heap.insert(0, 0.0);
-        for (int v = 1; v < n; v++)
-            handles[v] = heap.insert(v, INF);
-
-        while (!heap.empty()) {
-            auto [u, d] = heap.extract_min();
-            visited[u] = true;
-            if (d == INF) break;
-
-            for (const auto& edge : g.adj[u]) {
-                int v = edge.to;
-                if (!visited[v]) {
-                    double new_dist = dist[u] + edge.weight;
-                    if (new_dist < dist[v]) {
-                        dist[v] = new_dist;
-                        parent[v] = u;
-                        heap.decrease_key(handles[v], new_dist);
-                    }
-                }
-            }
-        }
+        return record("Dijkstra", heap, g, graph_type, mode, start, end, vis,
+                      distance_sum(result.dist));
+    }
 
+    // run_dijkstra with the heap's shape telemetry (heap_shape.h) collected into stats
+    template<typename Heap, typename G>
+    static BenchmarkResult run_dijkstra_shape(const G& g, const std::string& graph_type,
+                                              typename Heap::ShapeStats& stats,
+                                              InsertMode mode = InsertMode::Eager) {
+        trace::Zone zone(std::string("Dijkstra ") + Heap::name() + " " + graph_type, "benchmark");
+        Heap heap;
+        heap.shape_stats = &stats;
+        BenchmarkVisitor vis;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto result = dijkstra(g, typename G::Vertex(0), mode, heap, vis);
         auto end = std::chrono::high_resolution_clock::now();
-        double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
 
-        double dist_sum = 0;
-        for (double d : dist)
-            if (d != INF) dist_sum += d;
+        return record("Dijkstra", heap, g, graph_type, mode, start, end, vis,
+                      distance_sum(result.dist));
+    }
 
-        BenchmarkResult res;
-        res.algorithm = "Dijkstra";
-        res.heap_type = Heap::name();
-        res.graph_type = graph_type;
-        res.num_vertices = n;
-        res.num_edges = g.edge_count();
-        res.total_time_ms = total_ms;
-        res.insert_ops = heap.insert_count;
-        res.extract_min_ops = heap.extract_min_count;
-        res.decrease_key_ops = heap.decrease_key_count;
-        res.extract_min_time_ms = heap.extract_min_time_ns / 1e6;
-        res.decrease_key_time_ms = heap.decrease_key_time_ns / 1e6;
-        res.result_value = dist_sum;
+    template<typename Heap, typename G>
+    static BenchmarkResult run_prim(const G& g, const std::string& graph_type,
+                                    InsertMode mode = InsertMode::Eager) {
+        trace::Zone zone(std::string("Prim ") + Heap::name() + " " + graph_type, "benchmark");
+        Heap heap;
+        BenchmarkVisitor vis;
 
-        results.push_back(res);
-        return res;
+        auto start = std::chrono::high_resolution_clock::now();
+        auto result = prim(g, mode, heap, vis);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        return record("Prim", heap, g, graph_type, mode, start, end, vis, result.total_weight);
     }
 
-    template<typename Heap>
-    static BenchmarkResult run_prim(const Graph& g, const std::string& graph_type) {
-        int n = g.size();
-        const double INF = std::numeric_limits<double>::infinity();
+    // Lazy-deletion Dijkstra for queues without decrease-key (e.g. SequenceHeap).
+    // Reported as "Dijkstra" so verify_results checks it against the handle-based runs
+    template<typename Queue, typename G>
+    static BenchmarkResult run_dijkstra_lazy(const G& g, const std::string& graph_type) {
+        trace::Zone zone(std::string("Dijkstra ") + Queue::name() + " " + graph_type, "benchmark");
+        Queue queue;
+        BenchmarkVisitor vis;
 
-        std::vector<double> key(n, INF);
-        std::vector<int> parent(n, -1);
-        std::vector<typename Heap::Handle*> handles(n, nullptr);
-        std::vector<bool> in_mst(n, false);
+        auto start = std::chrono::high_resolution_clock::now();
+        auto result = dijkstra_lazy(g, typename G::Vertex(0), queue, vis);
+        auto end = std::chrono::high_resolution_clock::now();
 
-        Heap heap;
+        return record("Dijkstra", queue, g, graph_type, InsertMode::Lazy, start, end, vis,
+                      distance_sum(result.dist));
+    }
 
+    // Heap-free O(V^2) searches over an AdjacencyMatrix ("DenseMatrix" rows).
+    // Building the matrix is the init phase; ExtMin counts argmin scans and
+    // DecKey counts improved keys.
+    static BenchmarkResult run_dijkstra_matrix(const Graph& g, const std::string& graph_type) {
+        trace::Zone zone("Dijkstra DenseMatrix " + graph_type, "benchmark");
+        DenseScanStats stats;
         auto start = std::chrono::high_resolution_clock::now();
+        AdjacencyMatrix m(g);
+        auto built = std::chrono::high_resolution_clock::now();
+        auto result = dense_dijkstra(m, 0, &stats);
+        auto end = std::chrono::high_resolution_clock::now();
+        trace::complete("matrix build", "search", start, built);
+        trace::complete("search loop", "search", built, end);
 
-        key[0] = 0.0;
-        handles[0] = heap.insert(0, 0.0);
-        for (int v = 1; v < n; v++)
-            handles[v] = heap.insert(v, INF);
-
-        double total_weight = 0.0;
-
-        while (!heap.empty()) {
-            auto [u, d] = heap.extract_min();
-            in_mst[u] = true;
-            if (d == INF) break;
-            total_weight += d;
-
-            for (const auto& edge : g.adj[u]) {
-                int v = edge.to;
-                if (!in_mst[v] && edge.weight < key[v]) {
-                    key[v] = edge.weight;
-                    parent[v] = u;
-                    heap.decrease_key(handles[v], edge.weight);
-                }
-            }
-        }
+        return record_dense("Dijkstra", g, graph_type, start, built, end, stats,
+                            distance_sum(result.dist));
+    }
 
+    static BenchmarkResult run_prim_matrix(const Graph& g, const std::string& graph_type) {
+        trace::Zone zone("Prim DenseMatrix " + graph_type, "benchmark");
+        DenseScanStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        AdjacencyMatrix m(g);
+        auto built = std::chrono::high_resolution_clock::now();
+        auto result = dense_prim(m, &stats);
         auto end = std::chrono::high_resolution_clock::now();
-        double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        trace::complete("matrix build", "search", start, built);
+        trace::complete("search loop", "search", built, end);
+
+        return record_dense("Prim", g, graph_type, start, built, end, stats, result.total_weight);
+    }
 
+    // "Hold" model for queue-size sweeps: fill the queue with queue_size random
+    // keys, then time queue_size rounds of extract-min followed by re-insert
+    // with a slightly larger key (the access pattern of a Dijkstra frontier).
+    // Returns nanoseconds per round; queue size stays constant throughout.
+    template<typename Queue>
+    static double time_hold_ops(int queue_size, int seed = 42) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> initial(0.0, 1e6);
+        std::uniform_real_distribution<double> step(1.0, 100.0);
+
+        Queue queue;
+        for (int i = 0; i < queue_size; i++)
+            queue.insert(i, initial(rng));
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < queue_size; i++) {
+            auto [v, k] = queue.extract_min();
+            queue.insert(v, k + step(rng));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / queue_size;
+    }
+
+    template<typename Key>
+    static double distance_sum(const std::vector<Key>& dist) {
+        double sum = 0;
+        for (Key d : dist)
+            if (d != infinite_weight<Key>()) sum += static_cast<double>(d);
+        return sum;
+    }
+
+    // Fill a result row from the heap's metrics and the visitor's phase data
+    template<typename Heap, typename G, typename TimePoint>
+    static BenchmarkResult record(const char* algorithm, const Heap& heap, const G& g,
+                                  const std::string& graph_type, InsertMode mode,
+                                  TimePoint start, TimePoint end,
+                                  const BenchmarkVisitor& vis, double result_value) {
         BenchmarkResult res;
-        res.algorithm = "Prim";
+        res.algorithm = algorithm;
         res.heap_type = Heap::name();
         res.graph_type = graph_type;
-        res.num_vertices = n;
+        res.num_vertices = g.size();
         res.num_edges = g.edge_count();
-        res.total_time_ms = total_ms;
+        res.insert_mode = mode == InsertMode::Eager ? "eager" : "lazy";
+        res.total_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        res.init_time_ms = vis.init_time_ms;
         res.insert_ops = heap.insert_count;
         res.extract_min_ops = heap.extract_min_count;
         res.decrease_key_ops = heap.decrease_key_count;
         res.extract_min_time_ms = heap.extract_min_time_ns / 1e6;
         res.decrease_key_time_ms = heap.decrease_key_time_ns / 1e6;
-        res.result_value = total_weight;
+        res.peak_heap_size = vis.peak_heap_size;
+        res.result_value = result_value;
+        res.extract_min_latency = heap.extract_min_latency.summary();
+        res.decrease_key_latency = heap.decrease_key_latency.summary();
 
-        results.push_back(res);
+        add_result(res);
+        return res;
+    }
+
+    template<typename TimePoint>
+    static BenchmarkResult record_dense(const char* algorithm, const Graph& g,
+                                        const std::string& graph_type, TimePoint start,
+                                        TimePoint built, TimePoint end,
+                                        const DenseScanStats& stats, double result_value) {
+        BenchmarkResult res;
+        res.algorithm = algorithm;
+        res.heap_type = "DenseMatrix";
+        res.graph_type = graph_type;
+        res.num_vertices = g.size();
+        res.num_edges = g.edge_count();
+        res.insert_mode = "eager";
+        res.total_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        res.init_time_ms = std::chrono::duration<double, std::milli>(built - start).count();
+        res.insert_ops = 0;
+        res.extract_min_ops = stats.scans;
+        res.decrease_key_ops = stats.improvements;
+        res.extract_min_time_ms = 0;
+        res.decrease_key_time_ms = 0;
+        res.peak_heap_size = static_cast<std::size_t>(g.size());
+        res.result_value = result_value;
+
+        add_result(res);
         return res;
     }
 
+    // Result rows may be recorded from several threads (BenchmarkExecutor)
+    static void add_result(const BenchmarkResult& res) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.push_back(res);
+    }
+
+    static std::size_t result_count() {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        return results.size();
+    }
+
+    // Replace the rows recorded since `first` (in completion order) with `rows`
+    static void replace_results_since(std::size_t first, const std::vector<BenchmarkResult>& rows) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.resize(std::min(first, results.size()));
+        results.insert(results.end(), rows.begin(), rows.end());
+    }
+
     static void print_header() {
         std::cout << std::left
                   << std::setw(10) << "Algo"
@@ -162,15 +287,18 @@ public:
                   << std::setw(14) << "Graph"
                   << std::setw(8)  << "|V|"
                   << std::setw(10) << "|E|"
+                  << std::setw(7)  << "Mode"
                   << std::setw(12) << "Time(ms)"
+                  << std::setw(10) << "Init(ms)"
                   << std::setw(9)  << "Inserts"
                   << std::setw(9)  << "ExtMin"
                   << std::setw(9)  << "DecKey"
                   << std::setw(13) << "ExtMin(ms)"
                   << std::setw(13) << "DecKey(ms)"
+                  << std::setw(9)  << "Peak"
                   << std::setw(14) << "Result"
                   << std::endl;
-        std::cout << std::string(127, '-') << std::endl;
+        std::cout << std::string(153, '-') << std::endl;
     }
 
     static void print_result(const BenchmarkResult& r) {
@@ -180,16 +308,69 @@ public:
                   << std::setw(14) << r.graph_type
                   << std::setw(8)  << r.num_vertices
                   << std::setw(10) << r.num_edges
+                  << std::setw(7)  << r.insert_mode
                   << std::setw(12) << std::fixed << std::setprecision(3) << r.total_time_ms
+                  << std::setw(10) << std::fixed << std::setprecision(3) << r.init_time_ms
                   << std::setw(9)  << r.insert_ops
                   << std::setw(9)  << r.extract_min_ops
                   << std::setw(9)  << r.decrease_key_ops
                   << std::setw(13) << std::fixed << std::setprecision(3) << r.extract_min_time_ms
                   << std::setw(13) << std::fixed << std::setprecision(3) << r.decrease_key_time_ms
+                  << std::setw(9)  << r.peak_heap_size
                   << std::setw(14) << std::fixed << std::setprecision(2) << r.result_value
                   << std::endl;
     }
 
+    // Tail latency per heap operation: where the mean hides rare expensive
+    // operations (consolidate, cascading cuts), p99.9 and max show them
+    static void print_latency_header() {
+        std::cout << std::left
+                  << std::setw(10) << "Algo"
+                  << std::setw(16) << "Heap"
+                  << std::setw(14) << "Graph"
+                  << std::setw(8)  << "|V|"
+                  << std::setw(8)  << "Op"
+                  << std::setw(11) << "Samples"
+                  << std::setw(10) << "Mean(ns)"
+                  << std::setw(10) << "p50(ns)"
+                  << std::setw(10) << "p99(ns)"
+                  << std::setw(11) << "p99.9(ns)"
+                  << std::setw(12) << "Max(ns)"
+                  << std::setw(8)  << "Max/p50"
+                  << std::endl;
+        std::cout << std::string(128, '-') << std::endl;
+    }
+
+    static void print_latency(const BenchmarkResult& r) {
+        auto row = [&](const char* op, const LatencySummary& l, int ops, double time_ms) {
+            if (l.samples == 0) return;
+            std::cout << std::left
+                      << std::setw(10) << r.algorithm
+                      << std::setw(16) << r.heap_type
+                      << std::setw(14) << r.graph_type
+                      << std::setw(8)  << r.num_vertices
+                      << std::setw(8)  << op
+                      << std::setw(11) << l.samples
+                      << std::fixed << std::setprecision(0)
+                      << std::setw(10) << (ops ? time_ms * 1e6 / ops : 0.0)
+                      << std::setw(10) << l.p50
+                      << std::setw(10) << l.p99
+                      << std::setw(11) << l.p999
+                      << std::setw(12) << l.max
+                      << std::setprecision(1)
+                      << std::setw(8)  << (l.p50 > 0 ? l.max / l.p50 : 0.0)
+                      << std::endl;
+        };
+        row("ExtMin", r.extract_min_latency, r.extract_min_ops, r.extract_min_time_ms);
+        row("DecKey", r.decrease_key_latency, r.decrease_key_ops, r.decrease_key_time_ms);
+    }
+
+    static void print_latency_summary() {
+        std::cout << "\n========== OPERATION LATENCY ==========\n\n";
+        print_latency_header();
+        for (const auto& r : results) print_latency(r);
+    }
+
     static void print_all_results() {
         print_header();
         for (const auto& r : results) {
@@ -201,6 +382,13 @@ public:
         std::cout << "\n========== CORRECTNESS VERIFICATION ==========\n\n";
         bool all_ok = true;
 
+        for (const auto& r : results) {
+            if (r.algorithm == "FAILED") {
+                std::cout << "  FAILED RUN: " << r.heap_type << std::endl;
+                all_ok = false;
+            }
+        }
+
         for (size_t i = 0; i < results.size(); i++) {
             for (size_t j = i + 1; j < results.size(); j++) {
                 if (results[i].algorithm == results[j].algorithm &&
@@ -232,6 +420,7 @@ public:
             for (const auto& r : results) {
                 if (r.algorithm == algo) {
                     std::cout << "  " << std::setw(14) << std::left << r.heap_type
+                              << " " << std::setw(5) << r.insert_mode
                               << " | " << std::setw(12) << r.graph_type
                               << " | V=" << std::setw(6) << r.num_vertices
                               << " E=" << std::setw(10) << r.num_edges
@@ -239,6 +428,7 @@ public:
                               << r.total_time_ms << " ms"
                               << " | dk=" << r.decrease_key_ops
                               << " em=" << r.extract_min_ops
+                              << " peak=" << r.peak_heap_size
                               << "\n";
                 }
             }
@@ -248,3 +438,4 @@ public:
 };
 
 std::vector<BenchmarkResult> Benchmark::results;
+std::mutex Benchmark::results_mutex;
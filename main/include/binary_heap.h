@@ -2,20 +2,28 @@
 // Binary Heap (min-heap) baseline for graph algorithms
 // Supports: insert (returns handle), extract-min, decrease-key, find-min
 // Includes built-in metrics tracking for benchmarking
+// Templated on key and vertex-id types; BinaryHeap is the double/int default
 
+#include "trace.h"
+#include "latency_histogram.h"
+#include "heap_shape.h"
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <chrono>
 
-class BinaryHeap {
+template<typename KeyT = double, typename VertexT = int>
+class BasicBinaryHeap {
 public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
     struct Node {
-        double key;
-        int vertex;
+        Key key;
+        Vertex vertex;
         int index; // position in the heap array
 
-        Node(double k, int v, int i) : key(k), vertex(v), index(i) {}
+        Node(Key k, Vertex v, int i) : key(k), vertex(v), index(i) {}
     };
 
     using Handle = Node;
@@ -26,50 +34,73 @@ public:
     int decrease_key_count = 0;
     double extract_min_time_ns = 0;
     double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+    using ShapeStats = BinaryShapeStats;
+    ShapeStats* shape_stats = nullptr; // optional shape telemetry (heap_shape.h)
 
-    BinaryHeap() {}
+    BasicBinaryHeap() {}
 
-    ~BinaryHeap() {
-        for (auto* node : heap)
-            delete node;
-    }
+    ~BasicBinaryHeap() { clear(); }
 
     // Insert a vertex with given priority; returns a handle for decrease-key
-    Handle* insert(int vertex, double priority) {
+    Handle* insert(Vertex vertex, Key priority) {
         insert_count++;
         int idx = static_cast<int>(heap.size());
         Node* node = new Node(priority, vertex, idx);
         heap.push_back(node);
-        sift_up(idx);
+        int levels = sift_up(idx);
+        if (shape_stats) shape_stats->insert_up.add(levels);
         return node;
     }
 
+    // Bulk-load (vertex, priority) pairs with Floyd's bottom-up heapify in O(n);
+    // returns the handles in the same order as items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        heap.reserve(heap.size() + items.size());
+        for (const auto& [vertex, priority] : items) {
+            Node* node = new Node(priority, vertex, static_cast<int>(heap.size()));
+            heap.push_back(node);
+            handles.push_back(node);
+        }
+        for (int i = static_cast<int>(heap.size()) / 2 - 1; i >= 0; i--)
+            sift_down(i);
+        return handles;
+    }
+
     // Remove and return the minimum element as (vertex, priority)
-    std::pair<int, double> extract_min() {
+    std::pair<Vertex, Key> extract_min() {
         auto start = std::chrono::high_resolution_clock::now();
         extract_min_count++;
 
         Node* min_node = heap[0];
-        int vertex = min_node->vertex;
-        double key = min_node->key;
+        Vertex vertex = min_node->vertex;
+        Key key = min_node->key;
 
         int last = static_cast<int>(heap.size()) - 1;
         swap_nodes(0, last);
         heap.pop_back();
         delete min_node;
 
-        if (!heap.empty())
-            sift_down(0);
+        if (!heap.empty()) {
+            int levels = sift_down(0);
+            if (shape_stats) shape_stats->extract_down.add(levels);
+        }
 
         auto end = std::chrono::high_resolution_clock::now();
         extract_min_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
 
         return {vertex, key};
     }
 
     // Decrease the priority of a previously inserted node
-    void decrease_key(Handle* node, double new_key) {
+    void decrease_key(Handle* node, Key new_key) {
         auto start = std::chrono::high_resolution_clock::now();
         decrease_key_count++;
 
@@ -77,30 +108,44 @@ public:
             auto end = std::chrono::high_resolution_clock::now();
             decrease_key_time_ns += static_cast<double>(
                 std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
             return;
         }
 
         node->key = new_key;
-        sift_up(node->index);
+        int levels = sift_up(node->index);
+        if (shape_stats) shape_stats->decrease_up.add(levels);
 
         auto end = std::chrono::high_resolution_clock::now();
         decrease_key_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
     }
 
     bool empty() const { return heap.empty(); }
     int size() const { return static_cast<int>(heap.size()); }
 
-    std::pair<int, double> find_min() const {
+    std::pair<Vertex, Key> find_min() const {
         return {heap[0]->vertex, heap[0]->key};
     }
 
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        for (auto* node : heap)
+            delete node;
+        heap.clear();
+    }
+
     void reset_metrics() {
         insert_count = 0;
         extract_min_count = 0;
         decrease_key_count = 0;
         extract_min_time_ns = 0;
         decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
     }
 
     static const char* name() { return "BinaryHeap"; }
@@ -114,20 +159,25 @@ private:
         heap[j]->index = j;
     }
 
-    void sift_up(int i) {
+    // Both sifts return the number of levels moved
+    int sift_up(int i) {
+        int levels = 0;
         while (i > 0) {
             int parent = (i - 1) / 2;
             if (heap[i]->key < heap[parent]->key) {
                 swap_nodes(i, parent);
                 i = parent;
+                levels++;
             } else {
                 break;
             }
         }
+        return levels;
     }
 
-    void sift_down(int i) {
+    int sift_down(int i) {
         int sz = static_cast<int>(heap.size());
+        int levels = 0;
         while (true) {
             int smallest = i;
             int left = 2 * i + 1;
@@ -139,9 +189,13 @@ private:
             if (smallest != i) {
                 swap_nodes(i, smallest);
                 i = smallest;
+                levels++;
             } else {
                 break;
             }
         }
+        return levels;
     }
 };
+
+using BinaryHeap = BasicBinaryHeap<>;
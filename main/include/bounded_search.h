@@ -0,0 +1,146 @@
+#pragma once
+// Bounded Dijkstra queries with sparse results
+// The search stops as soon as the question is answered instead of settling
+// the whole graph:
+//   k_nearest(g, s, k, ws)               - the k closest vertices (incl. s)
+//   within_radius(g, s, radius, ws)      - every vertex with dist <= radius
+//   to_targets(g, s, targets, ws)        - until every target is settled
+//   nearest_targets(g, s, targets, k, ws) - the k closest targets ("nearest
+//                                           facilities"), stopping at the k-th
+// All run on a reusable SearchWorkspace (lazy insertion, epoch-reset labels),
+// so a query costs O(settled + touched) rather than O(V), and return only the
+// settled vertices in distance order. Tentative labels of vertices touched
+// but not settled stay readable in the workspace until the next query.
+
+#include "graph.h"
+#include "search_engine.h"
+#include "search_workspace.h"
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// Settled vertices in nondecreasing distance order; parent[i] is the
+// shortest-path-tree parent of vertices[i] (no_vertex for the source)
+template<typename Key = double, typename Vertex = int>
+struct BasicSparseResult {
+    std::vector<Vertex> vertices;
+    std::vector<Key> dist;
+    std::vector<Vertex> parent;
+
+    std::size_t size() const { return vertices.size(); }
+};
+
+using SparseResult = BasicSparseResult<>;
+
+template<typename Heap>
+using SparseResultFor = BasicSparseResult<typename Heap::Key, typename Heap::Vertex>;
+
+namespace bounded_detail {
+
+// Stop after the limit-th settled vertex
+struct SettleLimit {
+    std::size_t limit;
+    std::size_t settled = 0;
+
+    template<typename Vertex, typename Key>
+    bool before_settle(Vertex, Key) { return false; }
+    template<typename Vertex, typename Key>
+    bool after_settle(Vertex, Key) { return ++settled >= limit; }
+};
+
+// Stop before settling the first vertex farther than radius
+template<typename Key>
+struct RadiusLimit {
+    Key radius;
+
+    template<typename Vertex>
+    bool before_settle(Vertex, Key d) { return d > radius; }
+    template<typename Vertex>
+    bool after_settle(Vertex, Key) { return false; }
+};
+
+// Stop once `needed` of the (sorted, deduplicated) targets are settled
+template<typename Vertex>
+struct TargetLimit {
+    const std::vector<Vertex>& targets;
+    std::size_t needed;
+    std::size_t found = 0;
+
+    template<typename Key>
+    bool before_settle(Vertex, Key) { return false; }
+    template<typename Key>
+    bool after_settle(Vertex v, Key) {
+        return std::binary_search(targets.begin(), targets.end(), v) && ++found >= needed;
+    }
+};
+
+// Records settled vertices in order
+template<typename Key, typename Vertex>
+struct SettledCollector : NullSearchVisitor {
+    BasicSparseResult<Key, Vertex>& out;
+
+    explicit SettledCollector(BasicSparseResult<Key, Vertex>& o) : out(o) {}
+    void on_settle(Vertex v, Key d) {
+        out.vertices.push_back(v);
+        out.dist.push_back(d);
+    }
+};
+
+template<typename Heap, typename G, typename Stop>
+SparseResultFor<Heap> run(const G& g, typename G::Vertex source, SearchWorkspace<Heap>& ws, Stop stop) {
+    SparseResultFor<Heap> out;
+    ws.reset();
+    SettledCollector<typename Heap::Key, typename Heap::Vertex> vis(out);
+    dijkstra_search(g, source, InsertMode::Lazy, ws.heap(), ws, vis, stop);
+    out.parent.reserve(out.vertices.size());
+    for (auto v : out.vertices) out.parent.push_back(ws.parent(v));
+    return out;
+}
+
+} // namespace bounded_detail
+
+template<typename Heap, typename G>
+SparseResultFor<Heap> k_nearest(const G& g, typename G::Vertex source, std::size_t k,
+                                SearchWorkspace<Heap>& ws) {
+    if (k == 0) return {};
+    return bounded_detail::run(g, source, ws, bounded_detail::SettleLimit{k});
+}
+
+template<typename Heap, typename G>
+SparseResultFor<Heap> within_radius(const G& g, typename G::Vertex source, typename Heap::Key radius,
+                                    SearchWorkspace<Heap>& ws) {
+    return bounded_detail::run(g, source, ws, bounded_detail::RadiusLimit<typename Heap::Key>{radius});
+}
+
+// Settles vertices until the k closest targets are settled (all of them by
+// default); the result lists every vertex settled on the way. If fewer
+// targets are reachable, the source's whole component is settled.
+template<typename Heap, typename G>
+SparseResultFor<Heap> nearest_targets(const G& g, typename G::Vertex source,
+                                      std::vector<typename G::Vertex> targets, std::size_t k,
+                                      SearchWorkspace<Heap>& ws) {
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    k = std::min(k, targets.size());
+    if (k == 0) return {};
+    return bounded_detail::run(g, source, ws,
+                               bounded_detail::TargetLimit<typename G::Vertex>{targets, k});
+}
+
+template<typename Heap, typename G>
+SparseResultFor<Heap> to_targets(const G& g, typename G::Vertex source,
+                                 std::vector<typename G::Vertex> targets, SearchWorkspace<Heap>& ws) {
+    std::size_t k = targets.size();
+    return nearest_targets(g, source, std::move(targets), k, ws);
+}
+
+// The settled entries of result that are targets, closest first
+template<typename Key, typename Vertex>
+std::vector<Vertex> settled_targets(const BasicSparseResult<Key, Vertex>& result,
+                                    std::vector<Vertex> targets) {
+    std::sort(targets.begin(), targets.end());
+    std::vector<Vertex> out;
+    for (Vertex v : result.vertices)
+        if (std::binary_search(targets.begin(), targets.end(), v)) out.push_back(v);
+    return out;
+}
@@ -0,0 +1,128 @@
+#pragma once
+// Least-squares fitting of measurements to two-term complexity models
+// A model is value ≈ a·f(V, E) + b·g(V, E), e.g. a·E + b·V·log V. Fits
+// minimize the relative error (each sample is weighted by 1 / value), so
+// small and large sizes count equally across a doubling sweep. Negative
+// coefficients usually have no cost interpretation: if the unconstrained
+// fit gives one, each single-term fit is tried instead and the better one
+// kept (a negative a is kept when allow_negative_a is set).
+//   fit_model(model, samples[, allow_negative_a]) - constants and relative RMS error
+//   best_fit(models, samples)   - the model with the lowest error
+// Within one graph family E / V is fixed, so E and V terms are collinear and
+// only models pairing a linear with a V*log V term can be fitted; for one
+// family a*E + b*V*log V = V*(a*E/V + b*log V). There a negative a is a
+// meaningful offset, so fit with allow_negative_a: the per-vertex cost then
+// grows faster than log V over the measured range, e.g. as the graph falls
+// out of cache. b stays non-negative, so the fit never extrapolates a cost
+// that shrinks with size.
+// Fitted constants are in the sample's unit per term unit (e.g. ns per
+// E·log V), so predict() extrapolates to sizes that weren't measured.
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+
+struct ScalingSample {
+    double vertices;
+    double edges;
+    double value; // time (ns) or operation count
+};
+
+struct ComplexityModel {
+    std::string name;            // e.g. "a*E + b*V*log V"; ASCII so setw() aligns it
+    double (*term_a)(double V, double E);
+    double (*term_b)(double V, double E);
+};
+
+struct ModelFit {
+    std::string model;
+    double a = 0, b = 0;
+    double rms_rel_error = std::numeric_limits<double>::infinity();
+    double (*term_a)(double, double) = nullptr;
+    double (*term_b)(double, double) = nullptr;
+
+    double predict(double V, double E) const { return a * term_a(V, E) + b * term_b(V, E); }
+};
+
+namespace complexity_terms {
+inline double v(double V, double) { return V; }
+inline double e(double, double E) { return E; }
+inline double v_log_v(double V, double) { return V * std::log2(std::max(V, 2.0)); }
+inline double e_log_v(double V, double E) { return E * std::log2(std::max(V, 2.0)); }
+} // namespace complexity_terms
+
+// Fibonacci-style O(E + V log V), binary-heap O((E + V) log V), and linear
+inline std::vector<ComplexityModel> standard_models() {
+    using namespace complexity_terms;
+    return {
+        {"a*E + b*V*log V", e, v_log_v},
+        {"a*E*log V + b*V*log V", e_log_v, v_log_v},
+        {"a*E + b*V", e, v},
+    };
+}
+
+namespace complexity_detail {
+
+inline double rms_rel_error(const ModelFit& fit, const std::vector<ScalingSample>& samples) {
+    double sum = 0;
+    for (const auto& s : samples) {
+        double r = (fit.predict(s.vertices, s.edges) - s.value) / s.value;
+        sum += r * r;
+    }
+    return samples.empty() ? 0.0 : std::sqrt(sum / samples.size());
+}
+
+// Weighted least squares with the terms selected by use_a / use_b
+inline ModelFit solve(const ComplexityModel& m, const std::vector<ScalingSample>& samples,
+                      bool use_a, bool use_b) {
+    double saa = 0, sab = 0, sbb = 0, sa = 0, sb = 0;
+    for (const auto& s : samples) {
+        if (!(s.value > 0)) continue;
+        double fa = m.term_a(s.vertices, s.edges) / s.value;
+        double fb = m.term_b(s.vertices, s.edges) / s.value;
+        saa += fa * fa;
+        sab += fa * fb;
+        sbb += fb * fb;
+        sa += fa; // target is 1 after weighting
+        sb += fb;
+    }
+    ModelFit fit;
+    fit.model = m.name;
+    fit.term_a = m.term_a;
+    fit.term_b = m.term_b;
+    if (use_a && use_b) {
+        double det = saa * sbb - sab * sab;
+        if (std::fabs(det) < 1e-300) return fit;
+        fit.a = (sa * sbb - sb * sab) / det;
+        fit.b = (sb * saa - sa * sab) / det;
+    } else if (use_a) {
+        if (saa > 0) fit.a = sa / saa;
+    } else if (use_b) {
+        if (sbb > 0) fit.b = sb / sbb;
+    }
+    fit.rms_rel_error = rms_rel_error(fit, samples);
+    return fit;
+}
+
+} // namespace complexity_detail
+
+inline ModelFit fit_model(const ComplexityModel& m, const std::vector<ScalingSample>& samples,
+                          bool allow_negative_a = false) {
+    ModelFit both = complexity_detail::solve(m, samples, true, true);
+    if ((allow_negative_a || both.a >= 0) && both.b >= 0 && std::isfinite(both.rms_rel_error)) return both;
+    ModelFit only_a = complexity_detail::solve(m, samples, true, false);
+    ModelFit only_b = complexity_detail::solve(m, samples, false, true);
+    return only_a.rms_rel_error <= only_b.rms_rel_error ? only_a : only_b;
+}
+
+inline ModelFit best_fit(const std::vector<ComplexityModel>& models,
+                         const std::vector<ScalingSample>& samples) {
+    ModelFit best;
+    for (const auto& m : models) {
+        ModelFit f = fit_model(m, samples);
+        if (f.rms_rel_error < best.rms_rel_error) best = f;
+    }
+    return best;
+}
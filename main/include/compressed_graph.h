@@ -0,0 +1,224 @@
+#pragma once
+// Compressed read-only adjacency: sorted, delta + varint encoded neighbour lists
+// Each vertex's edges are sorted by target. The first target is stored as a
+// zigzag varint of (to - u), the rest as varint gaps to the previous target,
+// so local graphs (grids, reordered graphs) need 1 byte per target instead of
+// a 4-byte id plus padding. Weights live in a separate array:
+//   StoredWeight == Weight  - exact
+//   narrower unsigned type  - quantized linearly over [min, max] weight
+//                             (uint16_t: 65536 levels, uint8_t: 256); searches
+//                             then see the dequantized weights
+// adj[u] is a forward range that decodes on the fly and yields Edge values,
+// so the search engine's relax loop runs on it unchanged (the SIMD relax
+// path needs contiguous Edge arrays and is skipped).
+// Varints are LEB128: 7 bits per byte, high bit set on all but the last byte.
+
+#include "graph.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace varint {
+
+inline void put(std::vector<std::uint8_t>& out, std::uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(x));
+}
+
+// Decode one value at p and advance p; one-byte values take the fast path
+inline std::uint64_t get(const std::uint8_t*& p) {
+    std::uint64_t x = *p++;
+    if (x < 0x80) return x;
+    x &= 0x7f;
+    for (int shift = 7;; shift += 7) {
+        std::uint64_t b = *p++;
+        x |= (b & 0x7f) << shift;
+        if (b < 0x80) return x;
+    }
+}
+
+inline std::uint64_t zigzag(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t z) {
+    return static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+}
+
+} // namespace varint
+
+template<typename WeightT = double, typename VertexT = int, typename EdgeIdT = std::uint64_t,
+         typename StoredWeightT = WeightT>
+class BasicCompressedGraph {
+public:
+    using Weight = WeightT;
+    using Vertex = VertexT;
+    using EdgeId = EdgeIdT;
+    using StoredWeight = StoredWeightT;
+    using Edge = BasicEdge<Weight, Vertex>;
+
+    static constexpr bool quantized = !std::is_same<StoredWeight, Weight>::value;
+    static_assert(!quantized || (std::is_integral<StoredWeight>::value &&
+                                 std::is_unsigned<StoredWeight>::value),
+                  "quantized weights must be stored in an unsigned integer type");
+
+    // Weight decoding: exact copy, or min + level * step
+    struct WeightCodec {
+        Weight min = Weight(0);
+        double step = 1.0;
+
+        Weight decode(StoredWeight s) const {
+            if constexpr (quantized) {
+                double w = static_cast<double>(min) + static_cast<double>(s) * step;
+                return std::is_integral<Weight>::value ? static_cast<Weight>(w + 0.5)
+                                                       : static_cast<Weight>(w);
+            } else {
+                return s;
+            }
+        }
+    };
+
+    class Neighbors {
+    public:
+        class iterator {
+        public:
+            using value_type = Edge;
+            using difference_type = std::ptrdiff_t;
+            using reference = Edge;
+            using pointer = void;
+            using iterator_category = std::input_iterator_tag;
+
+            // left = edges from here to the end; the first target is decoded up front
+            iterator(const std::uint8_t* bytes, const StoredWeight* weight, std::size_t left,
+                     Vertex source, const WeightCodec* codec)
+                : p(bytes), w(weight), left(left), to(source), codec(codec) {
+                if (left)
+                    to = static_cast<Vertex>(static_cast<std::int64_t>(source) +
+                                             varint::unzigzag(varint::get(p)));
+            }
+
+            Edge operator*() const { return {to, codec->decode(*w)}; }
+
+            iterator& operator++() {
+                ++w;
+                if (--left) to = static_cast<Vertex>(to + static_cast<Vertex>(varint::get(p)));
+                return *this;
+            }
+
+            bool operator==(const iterator& o) const { return left == o.left; }
+            bool operator!=(const iterator& o) const { return left != o.left; }
+
+        private:
+            const std::uint8_t* p; // next gap
+            const StoredWeight* w; // current weight
+            std::size_t left;
+            Vertex to;             // current target
+            const WeightCodec* codec;
+        };
+
+        Neighbors(iterator first, iterator last, std::size_t count)
+            : first_(first), last_(last), count_(count) {}
+        iterator begin() const { return first_; }
+        iterator end() const { return last_; }
+        std::size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+
+    private:
+        iterator first_, last_;
+        std::size_t count_;
+    };
+
+    struct Adjacency {
+        std::vector<EdgeId> byte_offsets; // V + 1 entries into bytes
+        std::vector<EdgeId> edge_offsets; // V + 1 entries into weights
+        std::vector<std::uint8_t> bytes;
+        std::vector<StoredWeight> weights;
+        WeightCodec codec;
+
+        Neighbors operator[](std::size_t u) const {
+            using It = typename Neighbors::iterator;
+            auto count = static_cast<std::size_t>(edge_offsets[u + 1] - edge_offsets[u]);
+            Vertex v = static_cast<Vertex>(u);
+            return {It(bytes.data() + byte_offsets[u], weights.data() + edge_offsets[u], count, v, &codec),
+                    It(nullptr, nullptr, 0, v, &codec), count};
+        }
+        std::size_t size() const { return edge_offsets.empty() ? 0 : edge_offsets.size() - 1; }
+    };
+
+    Vertex num_vertices;
+    Adjacency adj;
+
+    explicit BasicCompressedGraph(const BasicGraph<Weight, Vertex, EdgeId>& g)
+        : num_vertices(g.size()) {
+        const std::size_t n = g.adj.size();
+        adj.byte_offsets.resize(n + 1);
+        adj.edge_offsets.resize(n + 1);
+        adj.weights.reserve(static_cast<std::size_t>(g.edge_count()));
+        adj.bytes.reserve(static_cast<std::size_t>(g.edge_count()) * 2);
+
+        if constexpr (quantized) {
+            Weight lo = infinite_weight<Weight>(), hi = std::numeric_limits<Weight>::lowest();
+            for (const auto& edges : g.adj)
+                for (const auto& e : edges) {
+                    lo = std::min(lo, e.weight);
+                    hi = std::max(hi, e.weight);
+                }
+            if (lo > hi) lo = hi = Weight(0);
+            adj.codec.min = lo;
+            adj.codec.step = static_cast<double>(hi - lo) /
+                             static_cast<double>(std::numeric_limits<StoredWeight>::max());
+        }
+
+        std::vector<Edge> sorted;
+        for (std::size_t u = 0; u < n; u++) {
+            adj.byte_offsets[u] = static_cast<EdgeId>(adj.bytes.size());
+            adj.edge_offsets[u] = static_cast<EdgeId>(adj.weights.size());
+            sorted.assign(g.adj[u].begin(), g.adj[u].end());
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const Edge& a, const Edge& b) { return a.to < b.to; });
+            for (std::size_t i = 0; i < sorted.size(); i++) {
+                if (i == 0)
+                    varint::put(adj.bytes, varint::zigzag(static_cast<std::int64_t>(sorted[0].to) -
+                                                          static_cast<std::int64_t>(u)));
+                else
+                    varint::put(adj.bytes, static_cast<std::uint64_t>(sorted[i].to - sorted[i - 1].to));
+                adj.weights.push_back(encode(sorted[i].weight));
+            }
+        }
+        adj.byte_offsets[n] = static_cast<EdgeId>(adj.bytes.size());
+        adj.edge_offsets[n] = static_cast<EdgeId>(adj.weights.size());
+        adj.bytes.shrink_to_fit();
+    }
+
+    Vertex size() const { return num_vertices; }
+    EdgeId edge_count() const { return static_cast<EdgeId>(adj.weights.size()); }
+
+    std::size_t memory_bytes() const {
+        return (adj.byte_offsets.capacity() + adj.edge_offsets.capacity()) * sizeof(EdgeId) +
+               adj.bytes.capacity() + adj.weights.capacity() * sizeof(StoredWeight);
+    }
+
+    // Largest |decoded - original| weight error (0 for exact storage)
+    double max_weight_error() const { return quantized ? adj.codec.step / 2 : 0.0; }
+
+private:
+    StoredWeight encode(Weight w) const {
+        if constexpr (quantized) {
+            double level = adj.codec.step > 0
+                               ? (static_cast<double>(w) - static_cast<double>(adj.codec.min)) / adj.codec.step
+                               : 0.0;
+            return static_cast<StoredWeight>(level + 0.5);
+        } else {
+            return w;
+        }
+    }
+};
+
+using CompressedGraph = BasicCompressedGraph<>;
+using QuantizedCompressedGraph = BasicCompressedGraph<double, int, std::uint64_t, std::uint16_t>;
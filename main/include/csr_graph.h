@@ -0,0 +1,81 @@
+#pragma once
+// Compressed sparse row (CSR) copy of a BasicGraph
+// All edges live in one contiguous array (vertex u's edges are
+// edges[offsets[u] .. offsets[u + 1])), so the adjacency is two large blocks
+// instead of V small vectors. That makes it the storage to put on huge pages
+// or spread across NUMA nodes: both arrays use PageAllocator with the policy
+// given at construction. adj[u] returns a range with begin / end / size /
+// data / operator[], so the search engine runs on it unchanged (including the
+// SIMD relax path). Read-only: build the BasicGraph first, then convert.
+
+#include "graph.h"
+#include "page_memory.h"
+#include <cstddef>
+#include <cstdint>
+
+template<typename WeightT = double, typename VertexT = int, typename EdgeIdT = std::uint64_t>
+class BasicCsrGraph {
+public:
+    using Weight = WeightT;
+    using Vertex = VertexT;
+    using EdgeId = EdgeIdT;
+    using Edge = BasicEdge<Weight, Vertex>;
+
+    // One vertex's out-edges
+    class Neighbors {
+    public:
+        Neighbors(const Edge* first, const Edge* last) : first_(first), last_(last) {}
+        const Edge* begin() const { return first_; }
+        const Edge* end() const { return last_; }
+        const Edge* data() const { return first_; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        bool empty() const { return first_ == last_; }
+        const Edge& operator[](std::size_t i) const { return first_[i]; }
+
+    private:
+        const Edge* first_;
+        const Edge* last_;
+    };
+
+    struct Adjacency {
+        PageVector<EdgeId> offsets; // V + 1 entries
+        PageVector<Edge> edges;
+
+        Neighbors operator[](std::size_t u) const {
+            return {edges.data() + offsets[u], edges.data() + offsets[u + 1]};
+        }
+        std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    };
+
+    Vertex num_vertices;
+    Adjacency adj;
+
+    explicit BasicCsrGraph(const BasicGraph<Weight, Vertex, EdgeId>& g,
+                           MemoryPolicy policy = page_memory::default_policy())
+        : num_vertices(g.size()),
+          adj{PageVector<EdgeId>(PageAllocator<EdgeId>(policy)),
+              PageVector<Edge>(PageAllocator<Edge>(policy))},
+          memory(policy) {
+        adj.offsets.resize(g.adj.size() + 1);
+        adj.edges.resize(static_cast<std::size_t>(g.edge_count()));
+        EdgeId next = 0;
+        for (std::size_t u = 0; u < g.adj.size(); u++) {
+            adj.offsets[u] = next;
+            for (const auto& e : g.adj[u]) adj.edges[next++] = e;
+        }
+        adj.offsets[g.adj.size()] = next;
+    }
+
+    Vertex size() const { return num_vertices; }
+    EdgeId edge_count() const { return static_cast<EdgeId>(adj.edges.size()); }
+    const MemoryPolicy& memory_policy() const { return memory; }
+
+    std::size_t memory_bytes() const {
+        return adj.offsets.capacity() * sizeof(EdgeId) + adj.edges.capacity() * sizeof(Edge);
+    }
+
+private:
+    MemoryPolicy memory;
+};
+
+using CsrGraph = BasicCsrGraph<>;
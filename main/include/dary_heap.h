@@ -0,0 +1,125 @@
+#pragma once
+// Implicit d-ary min-heap without handles
+// Entries are stored inline in one array (no per-node allocation), and a wider
+// fan-out (Arity children per node) gives a shallower tree whose children
+// share cache lines. Like SequenceHeap there is no decrease-key: it is meant
+// for the lazy-deletion pattern and as the sequential queue inside MultiQueue.
+// Supports: insert, extract-min, find-min
+// Includes built-in metrics tracking for benchmarking
+// Templated on arity, key and vertex-id types; DaryHeap is the 4-ary double/int default.
+// Alloc is the entry array's allocator template (e.g. PageAllocator from
+// page_memory.h to put a large queue on huge pages).
+
+#include "trace.h"
+#include "latency_histogram.h"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <chrono>
+#include <cstddef>
+
+template<int Arity = 4, typename KeyT = double, typename VertexT = int,
+         template<typename> class Alloc = std::allocator>
+class BasicDaryHeap {
+    static_assert(Arity >= 2, "a d-ary heap needs at least two children per node");
+
+public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
+    struct Entry {
+        Key key;
+        Vertex vertex;
+    };
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0; // always 0; kept for the benchmark interface
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    BasicDaryHeap() {}
+
+    // Insert a vertex with given priority
+    void insert(Vertex vertex, Key priority) {
+        insert_count++;
+        heap.push_back({priority, vertex});
+        sift_up(heap.size() - 1);
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<Vertex, Key> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        Entry top = heap[0];
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+            sift_down(0);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {top.vertex, top.key};
+    }
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    std::pair<Vertex, Key> find_min() const { return {heap[0].vertex, heap[0].key}; }
+
+    // Remove all elements; metrics are kept
+    void clear() { heap.clear(); }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return Arity == 4 ? "4-aryHeap" : "DaryHeap"; }
+
+private:
+    std::vector<Entry, Alloc<Entry>> heap;
+
+    void sift_up(std::size_t i) {
+        Entry e = heap[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / Arity;
+            if (!(e.key < heap[parent].key)) break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = e;
+    }
+
+    void sift_down(std::size_t i) {
+        Entry e = heap[i];
+        const std::size_t n = heap.size();
+        while (true) {
+            std::size_t first = i * Arity + 1;
+            if (first >= n) break;
+            std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; c++)
+                if (heap[c].key < heap[best].key) best = c;
+            if (!(heap[best].key < e.key)) break;
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = e;
+    }
+};
+
+using DaryHeap = BasicDaryHeap<>;
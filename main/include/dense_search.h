@@ -0,0 +1,458 @@
+#pragma once
+// Heap-free O(V^2) Dijkstra / Prim for dense graphs
+// When E is close to V^2 a heap only adds overhead: scanning a flat key array
+// for the minimum costs O(V) per step, O(V^2) in total, which is already the
+// cost of reading the edges. Two forms are provided:
+//   DenseArrayQueue - drop-in "heap" (same interface as the others) whose
+//                     extract-min is a vectorized argmin over a contiguous key
+//                     array; runs through the normal search engine
+//   AdjacencyMatrix - n x n weight matrix; dense_dijkstra / dense_prim relax a
+//                     whole row with SIMD compares instead of walking an edge list
+// The SIMD kernels follow simd_relax's runtime selection (Scalar / AVX2 / AVX-512).
+// is_dense() is the density test the benchmark harness uses to add these runs.
+
+#include "graph.h"
+#include "algorithms.h"
+#include "simd_relax.h"
+#include "trace.h"
+#include "latency_histogram.h"
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <limits>
+#include <chrono>
+#include <cstddef>
+
+// Density E / (V (V - 1)) above which the O(V^2) scans are worth running
+// (E counts both directions of an undirected edge). The `dense` benchmark mode
+// puts the matrix search (excluding the matrix build) level with the heaps
+// around 0.5 on random weights and about 2x ahead on complete graphs.
+constexpr double dense_density_threshold = 0.4;
+
+template<typename G>
+double graph_density(const G& g) {
+    double n = static_cast<double>(g.size());
+    return n > 1 ? static_cast<double>(g.edge_count()) / (n * (n - 1)) : 0.0;
+}
+
+template<typename G>
+bool is_dense(const G& g) { return graph_density(g) >= dense_density_threshold; }
+
+namespace dense_kernels {
+
+// Index of the smallest finite value in a[0, n) (first one on ties), or -1
+// when every value is +inf
+inline int argmin_scalar(const double* a, int n) {
+    int best = -1;
+    double best_key = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < n; i++) {
+        if (a[i] < best_key) {
+            best_key = a[i];
+            best = i;
+        }
+    }
+    return best;
+}
+
+// key[v] = base + row[v] + bias[v] where that is smaller (parent[v] = u).
+// bias is 0 for open vertices and +inf for settled ones, which keeps the
+// loop free of per-vertex branches on the settled flag.
+// Returns the number of keys improved.
+inline int relax_row_scalar(const double* row, double base, const double* bias,
+                            double* key, int* parent, int u, int n) {
+    int improved = 0;
+    for (int v = 0; v < n; v++) {
+        double cand = base + row[v] + bias[v];
+        if (cand < key[v]) {
+            key[v] = cand;
+            parent[v] = u;
+            improved++;
+        }
+    }
+    return improved;
+}
+
+#ifdef SIMD_RELAX_X86
+
+// Per-lane running minimum with its index; lanes are merged at the end,
+// preferring the lower index so the result matches the scalar scan
+__attribute__((target("avx2")))
+inline int argmin_avx2(const double* a, int n) {
+    const double INF = std::numeric_limits<double>::infinity();
+    __m256d best = _mm256_set1_pd(INF);
+    __m256d best_idx = _mm256_set1_pd(-1.0);
+    __m256d idx = _mm256_setr_pd(0, 1, 2, 3);
+    const __m256d step = _mm256_set1_pd(4.0);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        __m256d lt = _mm256_cmp_pd(x, best, _CMP_LT_OQ);
+        best = _mm256_blendv_pd(best, x, lt);
+        best_idx = _mm256_blendv_pd(best_idx, idx, lt);
+        idx = _mm256_add_pd(idx, step);
+    }
+
+    alignas(32) double lane_key[4];
+    alignas(32) double lane_idx[4];
+    _mm256_store_pd(lane_key, best);
+    _mm256_store_pd(lane_idx, best_idx);
+    int result = -1;
+    double result_key = INF;
+    for (int l = 0; l < 4; l++) {
+        int li = static_cast<int>(lane_idx[l]);
+        if (lane_key[l] < result_key || (lane_key[l] == result_key && li >= 0 && li < result)) {
+            result_key = lane_key[l];
+            result = li;
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] < result_key) {
+            result_key = a[i];
+            result = i;
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx512f")))
+inline int argmin_avx512(const double* a, int n) {
+    const double INF = std::numeric_limits<double>::infinity();
+    __m512d best = _mm512_set1_pd(INF);
+    __m512d best_idx = _mm512_set1_pd(-1.0);
+    __m512d idx = _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512d step = _mm512_set1_pd(8.0);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d x = _mm512_loadu_pd(a + i);
+        __mmask8 lt = _mm512_cmp_pd_mask(x, best, _CMP_LT_OQ);
+        best = _mm512_mask_blend_pd(lt, best, x);
+        best_idx = _mm512_mask_blend_pd(lt, best_idx, idx);
+        idx = _mm512_add_pd(idx, step);
+    }
+
+    alignas(64) double lane_key[8];
+    alignas(64) double lane_idx[8];
+    _mm512_store_pd(lane_key, best);
+    _mm512_store_pd(lane_idx, best_idx);
+    int result = -1;
+    double result_key = INF;
+    for (int l = 0; l < 8; l++) {
+        int li = static_cast<int>(lane_idx[l]);
+        if (lane_key[l] < result_key || (lane_key[l] == result_key && li >= 0 && li < result)) {
+            result_key = lane_key[l];
+            result = li;
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] < result_key) {
+            result_key = a[i];
+            result = i;
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx2")))
+inline int relax_row_avx2(const double* row, double base, const double* bias,
+                          double* key, int* parent, int u, int n) {
+    const __m256d vbase = _mm256_set1_pd(base);
+    int improved = 0;
+    int v = 0;
+    for (; v + 4 <= n; v += 4) {
+        __m256d cand = _mm256_add_pd(_mm256_add_pd(vbase, _mm256_loadu_pd(row + v)),
+                                     _mm256_loadu_pd(bias + v));
+        __m256d k = _mm256_loadu_pd(key + v);
+        __m256d lt = _mm256_cmp_pd(cand, k, _CMP_LT_OQ);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(lt));
+        if (mask) {
+            _mm256_storeu_pd(key + v, _mm256_blendv_pd(k, cand, lt));
+            improved += __builtin_popcount(mask);
+            while (mask) {
+                parent[v + __builtin_ctz(mask)] = u;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return improved + relax_row_scalar(row + v, base, bias + v, key + v, parent + v, u, n - v);
+}
+
+__attribute__((target("avx512f")))
+inline int relax_row_avx512(const double* row, double base, const double* bias,
+                            double* key, int* parent, int u, int n) {
+    const __m512d vbase = _mm512_set1_pd(base);
+    int improved = 0;
+    int v = 0;
+    for (; v + 8 <= n; v += 8) {
+        __m512d cand = _mm512_add_pd(_mm512_add_pd(vbase, _mm512_loadu_pd(row + v)),
+                                     _mm512_loadu_pd(bias + v));
+        __mmask8 lt = _mm512_cmp_pd_mask(cand, _mm512_loadu_pd(key + v), _CMP_LT_OQ);
+        if (lt) {
+            _mm512_mask_storeu_pd(key + v, lt, cand);
+            unsigned mask = lt;
+            improved += __builtin_popcount(mask);
+            while (mask) {
+                parent[v + __builtin_ctz(mask)] = u;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return improved + relax_row_scalar(row + v, base, bias + v, key + v, parent + v, u, n - v);
+}
+
+#endif // SIMD_RELAX_X86
+
+inline int argmin(const double* a, int n) {
+#ifdef SIMD_RELAX_X86
+    switch (simd_relax::active_kernel()) {
+    case simd_relax::Kernel::AVX512: return argmin_avx512(a, n);
+    case simd_relax::Kernel::AVX2: return argmin_avx2(a, n);
+    default: break;
+    }
+#endif
+    return argmin_scalar(a, n);
+}
+
+inline int relax_row(const double* row, double base, const double* bias,
+                     double* key, int* parent, int u, int n) {
+#ifdef SIMD_RELAX_X86
+    switch (simd_relax::active_kernel()) {
+    case simd_relax::Kernel::AVX512: return relax_row_avx512(row, base, bias, key, parent, u, n);
+    case simd_relax::Kernel::AVX2: return relax_row_avx2(row, base, bias, key, parent, u, n);
+    default: break;
+    }
+#endif
+    return relax_row_scalar(row, base, bias, key, parent, u, n);
+}
+
+} // namespace dense_kernels
+
+// Priority queue over vertex ids backed by a flat key array: insert and
+// decrease-key are O(1) stores, extract-min is an O(V) SIMD argmin.
+// Keys live in fixed-size chunks so handles (pointers to a vertex's key slot)
+// stay valid as higher vertex ids are inserted. Absent and extracted vertices
+// hold +inf, so the scan needs no separate membership test.
+// Supports: insert (returns handle), extract-min, decrease-key, find-min
+// Includes built-in metrics tracking for benchmarking
+class DenseArrayQueue {
+public:
+    using Key = double;
+    using Vertex = int;
+    using Handle = double; // points at the vertex's key slot
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0;
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    DenseArrayQueue() : n(0), limit(0) {}
+
+    DenseArrayQueue(const DenseArrayQueue&) = delete;
+    DenseArrayQueue& operator=(const DenseArrayQueue&) = delete;
+
+    // Insert a vertex with given priority; returns a handle for decrease-key
+    Handle* insert(int vertex, double priority) {
+        insert_count++;
+        ensure_capacity(vertex);
+        if (vertex >= limit) limit = vertex + 1;
+        double* slot = &chunks[vertex / CHUNK][vertex % CHUNK];
+        *slot = priority;
+        present[vertex] = 1;
+        n++;
+        return slot;
+    }
+
+    // Bulk-load (vertex, priority) pairs; stores only, O(n)
+    std::vector<Handle*> build(const std::vector<std::pair<int, double>>& items) {
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        for (const auto& [vertex, priority] : items)
+            handles.push_back(insert(vertex, priority));
+        return handles;
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<int, double> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        int vertex = locate_min();
+        double key = chunks[vertex / CHUNK][vertex % CHUNK];
+        chunks[vertex / CHUNK][vertex % CHUNK] = std::numeric_limits<double>::infinity();
+        present[vertex] = 0;
+        n--;
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {vertex, key};
+    }
+
+    // Decrease the priority of a previously inserted vertex
+    void decrease_key(Handle* slot, double new_key) {
+        auto start = std::chrono::high_resolution_clock::now();
+        decrease_key_count++;
+
+        if (new_key < *slot)
+            *slot = new_key;
+
+        auto end = std::chrono::high_resolution_clock::now();
+        decrease_key_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
+    }
+
+    bool empty() const { return n == 0; }
+    int size() const { return n; }
+
+    std::pair<int, double> find_min() {
+        int vertex = locate_min();
+        return {vertex, chunks[vertex / CHUNK][vertex % CHUNK]};
+    }
+
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        for (auto& chunk : chunks)
+            std::fill(chunk.get(), chunk.get() + CHUNK, std::numeric_limits<double>::infinity());
+        std::fill(present.begin(), present.end(), 0);
+        n = 0;
+        limit = 0;
+    }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return "DenseArray"; }
+
+private:
+    static constexpr int CHUNK = 4096;
+
+    std::vector<std::unique_ptr<double[]>> chunks;
+    std::vector<char> present; // 1 while the vertex is in the queue
+    int n;
+    int limit; // one past the highest vertex inserted; scans stop here
+
+    void ensure_capacity(int vertex) {
+        while (static_cast<int>(chunks.size()) <= vertex / CHUNK) {
+            chunks.emplace_back(new double[CHUNK]);
+            std::fill(chunks.back().get(), chunks.back().get() + CHUNK,
+                      std::numeric_limits<double>::infinity());
+        }
+        if (static_cast<int>(present.size()) <= vertex)
+            present.resize(chunks.size() * CHUNK, 0);
+    }
+
+    // Vertex with the smallest key; if every remaining key is +inf, any
+    // remaining vertex (the engine stops once it sees an infinite key)
+    int locate_min() const {
+        int best = -1;
+        double best_key = std::numeric_limits<double>::infinity();
+        for (int c = 0; c * CHUNK < limit; c++) {
+            int i = dense_kernels::argmin(chunks[c].get(), std::min(CHUNK, limit - c * CHUNK));
+            if (i >= 0 && chunks[c][i] < best_key) {
+                best_key = chunks[c][i];
+                best = c * CHUNK + i;
+            }
+        }
+        if (best < 0) {
+            for (int v = 0; v < limit; v++)
+                if (present[v]) return v;
+        }
+        return best;
+    }
+};
+
+// Row-major n x n weight matrix; +inf marks a missing edge and parallel edges
+// keep the lightest weight. Costs 8 n^2 bytes, so it is only meant for dense graphs.
+class AdjacencyMatrix {
+public:
+    explicit AdjacencyMatrix(const Graph& g)
+        : n(g.size()),
+          w(static_cast<std::size_t>(n) * n, std::numeric_limits<double>::infinity()) {
+        for (int u = 0; u < n; u++) {
+            double* r = &w[static_cast<std::size_t>(u) * n];
+            for (const auto& e : g.adj[u])
+                if (e.weight < r[e.to]) r[e.to] = e.weight;
+        }
+    }
+
+    int size() const { return n; }
+    const double* row(int u) const { return &w[static_cast<std::size_t>(u) * n]; }
+
+private:
+    int n;
+    std::vector<double> w;
+};
+
+// Scan counts for the matrix searches (argmin scans and improved keys)
+struct DenseScanStats {
+    int scans = 0;
+    int improvements = 0;
+};
+
+namespace dense_detail {
+
+// Shared Dijkstra / Prim loop over the matrix: Dijkstra relaxes with
+// base = dist[u], Prim with base = 0. Returns the sum of settled keys.
+inline double matrix_search(const AdjacencyMatrix& m, int start, bool prim_mode,
+                            std::vector<double>& settled_key, std::vector<int>& parent,
+                            DenseScanStats* stats) {
+    const double INF = std::numeric_limits<double>::infinity();
+    int n = m.size();
+    std::vector<double> key(n, INF);
+    std::vector<double> bias(n, 0.0);
+    settled_key.assign(n, INF);
+    parent.assign(n, -1);
+
+    double total = 0.0;
+    key[start] = 0.0;
+    for (int step = 0; step < n; step++) {
+        int u = dense_kernels::argmin(key.data(), n);
+        if (stats) stats->scans++;
+        if (u < 0) break; // remaining vertices unreachable
+
+        double d = key[u];
+        settled_key[u] = d;
+        total += d;
+        key[u] = INF;
+        bias[u] = INF;
+
+        int improved = dense_kernels::relax_row(m.row(u), prim_mode ? 0.0 : d, bias.data(),
+                                                key.data(), parent.data(), u, n);
+        if (stats) stats->improvements += improved;
+    }
+    return total;
+}
+
+} // namespace dense_detail
+
+// Dijkstra over an adjacency matrix: O(V^2) with SIMD argmin and row relaxation
+inline DijkstraResult dense_dijkstra(const AdjacencyMatrix& m, int source,
+                                     DenseScanStats* stats = nullptr) {
+    DijkstraResult result;
+    dense_detail::matrix_search(m, source, false, result.dist, result.parent, stats);
+    return result;
+}
+
+// Prim over an adjacency matrix (grown from vertex 0)
+inline PrimResult dense_prim(const AdjacencyMatrix& m, DenseScanStats* stats = nullptr) {
+    PrimResult result;
+    std::vector<double> key;
+    result.total_weight = dense_detail::matrix_search(m, 0, true, key, result.parent, stats);
+    return result;
+}
@@ -0,0 +1,274 @@
+#pragma once
+// Incremental single-source shortest paths under edge-weight changes
+// Instead of rerunning Dijkstra after a batch of changes, only the part of
+// the shortest-path tree that can change is repaired:
+//   decrease / insertion of u->v: if dist[u] + w < dist[v], v is re-queued and
+//     the improvement propagates Dijkstra-style from there
+//   increase of a tree edge parent[v] -> v: v's whole subtree is invalidated
+//     (dist = INF), each invalidated vertex is re-seeded from its best
+//     in-edge from outside the subtree, and the subtree is re-settled
+// Both cases run through one heap pass using the ordinary heap templates
+// (insert / extract-min / decrease-key), so the work is proportional to the
+// affected region instead of the whole graph.
+//   repair_sssp(g, source, result, updates)  - one-off repair; increases need
+//                                              an O(E) scan to find in-edges
+//   DynamicSssp<Heap>                         - owns the result and an in-edge
+//                                              index, so every case stays local
+
+#include "graph.h"
+#include "algorithms.h"
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// Set the weight of edge from -> to (every parallel copy); adds the edge if
+// it doesn't exist. Undirected graphs need one update per direction
+// (see both_directions).
+template<typename Weight = double, typename Vertex = int>
+struct BasicEdgeUpdate {
+    Vertex from;
+    Vertex to;
+    Weight weight;
+};
+
+using EdgeUpdate = BasicEdgeUpdate<>;
+
+// Each update plus its reverse, for graphs built with add_undirected_edge
+template<typename Weight, typename Vertex>
+std::vector<BasicEdgeUpdate<Weight, Vertex>>
+both_directions(const std::vector<BasicEdgeUpdate<Weight, Vertex>>& updates) {
+    std::vector<BasicEdgeUpdate<Weight, Vertex>> out;
+    out.reserve(2 * updates.size());
+    for (const auto& u : updates) {
+        out.push_back(u);
+        out.push_back({u.to, u.from, u.weight});
+    }
+    return out;
+}
+
+struct RepairStats {
+    std::size_t inserted_edges = 0;
+    std::size_t decreased_edges = 0;
+    std::size_t increased_edges = 0;
+    std::size_t invalidated = 0; // vertices in subtrees cut by tree-edge increases
+    std::size_t relabeled = 0;   // label writes during the repair (incl. re-seeding)
+    int heap_inserts = 0;
+    int heap_extracts = 0;
+    int heap_decrease_keys = 0;
+};
+
+namespace dynamic_detail {
+
+// Per-vertex scratch kept between repairs; only touched entries are reset
+template<typename Handle, typename Vertex>
+struct RepairScratch {
+    std::vector<Handle*> handle;
+    std::vector<char> invalid;
+    std::vector<Vertex> touched;
+
+    void resize(std::size_t n) {
+        handle.resize(n, nullptr);
+        invalid.resize(n, 0);
+    }
+    void reset() {
+        for (Vertex v : touched) {
+            handle[v] = nullptr;
+            invalid[v] = 0;
+        }
+        touched.clear();
+    }
+};
+
+// In-edge list entry: the edge is g.adj[from][index] (stable under push_back)
+template<typename Vertex>
+struct InEdge {
+    Vertex from;
+    std::size_t index;
+};
+
+template<typename Heap, typename G, typename Result, typename Update, typename InIndex>
+RepairStats repair(G& g, typename G::Vertex source, Result& r, const std::vector<Update>& updates,
+                   InIndex* in_edges,
+                   RepairScratch<typename Heap::Handle, typename G::Vertex>& scratch) {
+    using Key = typename G::Weight;
+    using Vertex = typename G::Vertex;
+    const Key INF = infinite_weight<Key>();
+    RepairStats stats;
+    scratch.resize(r.dist.size());
+
+    // 1. Apply the batch; remember the candidates for each kind of repair
+    std::vector<Update> lowered;     // inserted or decreased edges
+    std::vector<Vertex> cut_roots;   // heads of increased tree edges
+    for (const auto& up : updates) {
+        bool found = false, lower = false, higher = false;
+        for (auto& e : g.adj[up.from]) {
+            if (e.to != up.to) continue;
+            found = true;
+            if (up.weight < e.weight) lower = true;
+            if (up.weight > e.weight) higher = true;
+            e.weight = up.weight;
+        }
+        if (!found) {
+            g.adj[up.from].push_back({up.to, up.weight});
+            if (in_edges)
+                (*in_edges)[up.to].push_back({up.from, g.adj[up.from].size() - 1});
+            stats.inserted_edges++;
+            lower = true;
+        } else {
+            if (lower) stats.decreased_edges++;
+            if (higher) stats.increased_edges++;
+        }
+        if (lower) lowered.push_back(up);
+        if (higher && up.to != source && r.parent[up.to] == up.from) cut_roots.push_back(up.to);
+    }
+
+    Heap heap;
+    auto relabel = [&](Vertex v, Key d, Vertex p) {
+        r.dist[v] = d;
+        r.parent[v] = p;
+        stats.relabeled++;
+        if (!scratch.handle[v] && !scratch.invalid[v]) scratch.touched.push_back(v);
+        if (scratch.handle[v]) {
+            heap.decrease_key(scratch.handle[v], d);
+        } else {
+            scratch.handle[v] = heap.insert(v, d);
+        }
+    };
+
+    // 2. Invalidate the subtrees below increased tree edges (children are
+    //    found through out-edges, so this is local to the subtree)
+    std::vector<Vertex> invalid_list;
+    for (Vertex root : cut_roots) {
+        if (scratch.invalid[root]) continue;
+        std::vector<Vertex> stack{root};
+        scratch.invalid[root] = 1;
+        scratch.touched.push_back(root);
+        while (!stack.empty()) {
+            Vertex x = stack.back();
+            stack.pop_back();
+            invalid_list.push_back(x);
+            for (const auto& e : g.adj[x]) {
+                if (r.parent[e.to] == x && !scratch.invalid[e.to] && e.to != source) {
+                    scratch.invalid[e.to] = 1;
+                    scratch.touched.push_back(e.to);
+                    stack.push_back(e.to);
+                }
+            }
+        }
+    }
+    stats.invalidated = invalid_list.size();
+    for (Vertex v : invalid_list) {
+        r.dist[v] = INF;
+        r.parent[v] = no_vertex<Vertex>();
+    }
+
+    // 3. Re-seed invalidated vertices from their best in-edge outside the subtree
+    if (!invalid_list.empty()) {
+        if (in_edges) {
+            for (Vertex v : invalid_list) {
+                Key best = INF;
+                Vertex best_from = no_vertex<Vertex>();
+                for (const auto& ie : (*in_edges)[v]) {
+                    if (scratch.invalid[ie.from] || r.dist[ie.from] == INF) continue;
+                    Key cand = r.dist[ie.from] + g.adj[ie.from][ie.index].weight;
+                    if (cand < best) {
+                        best = cand;
+                        best_from = ie.from;
+                    }
+                }
+                if (best_from != no_vertex<Vertex>()) relabel(v, best, best_from);
+            }
+        } else {
+            // No in-edge index: one scan over every valid vertex's out-edges
+            for (std::size_t u = 0; u < g.adj.size(); u++) {
+                if (scratch.invalid[u] || r.dist[u] == INF) continue;
+                for (const auto& e : g.adj[u]) {
+                    if (!scratch.invalid[e.to]) continue;
+                    Key cand = r.dist[u] + e.weight;
+                    if (cand < r.dist[e.to]) relabel(e.to, cand, static_cast<Vertex>(u));
+                }
+            }
+        }
+    }
+
+    // 4. Seed the heads of inserted / decreased edges that now improve (the
+    //    weight is re-read: a later update in the batch may have changed it)
+    for (const auto& up : lowered) {
+        if (r.dist[up.from] == INF) continue; // settles later if reachable
+        for (const auto& e : g.adj[up.from]) {
+            if (e.to != up.to) continue;
+            Key cand = r.dist[up.from] + e.weight;
+            if (cand < r.dist[up.to]) relabel(up.to, cand, up.from);
+        }
+    }
+
+    // 5. Dijkstra over the affected region; a vertex improved again after it
+    //    was settled (by a later-seeded decrease) is simply re-queued
+    while (!heap.empty()) {
+        auto [u, d] = heap.extract_min();
+        scratch.handle[u] = nullptr;
+        if (d > r.dist[u]) continue;
+        for (const auto& e : g.adj[u]) {
+            Key cand = d + e.weight;
+            if (cand < r.dist[e.to]) relabel(e.to, cand, u);
+        }
+    }
+
+    stats.heap_inserts = heap.insert_count;
+    stats.heap_extracts = heap.extract_min_count;
+    stats.heap_decrease_keys = heap.decrease_key_count;
+    scratch.reset();
+    return stats;
+}
+
+} // namespace dynamic_detail
+
+// Apply a batch of edge updates to g and repair `result` (a Dijkstra result
+// from `source` on g before the batch). Increases of tree edges trigger an
+// O(E) in-edge scan; use DynamicSssp for repeated batches.
+template<typename Heap, typename G>
+RepairStats repair_sssp(G& g, typename G::Vertex source, DijkstraResultFor<Heap>& result,
+                        const std::vector<BasicEdgeUpdate<typename G::Weight, typename G::Vertex>>& updates) {
+    using Vertex = typename G::Vertex;
+    dynamic_detail::RepairScratch<typename Heap::Handle, Vertex> scratch;
+    std::vector<std::vector<dynamic_detail::InEdge<Vertex>>>* no_index = nullptr;
+    return dynamic_detail::repair<Heap>(g, source, result, updates, no_index, scratch);
+}
+
+// Shortest paths from one source kept up to date as the graph changes.
+// Holds a reference to the graph (updates are applied to it), the current
+// result, an in-edge index and reusable scratch arrays.
+template<typename Heap, typename G = Graph>
+class DynamicSssp {
+public:
+    using Vertex = typename G::Vertex;
+    using Weight = typename G::Weight;
+    using Update = BasicEdgeUpdate<Weight, Vertex>;
+    using Result = DijkstraResultFor<Heap>;
+
+    DynamicSssp(G& graph, Vertex source) : g(graph), src(source) {
+        in_edges.resize(g.adj.size());
+        for (std::size_t u = 0; u < g.adj.size(); u++)
+            for (std::size_t i = 0; i < g.adj[u].size(); i++)
+                in_edges[g.adj[u][i].to].push_back({static_cast<Vertex>(u), i});
+        recompute();
+    }
+
+    // Apply a batch of updates and repair the affected part of the tree
+    RepairStats apply(const std::vector<Update>& updates) {
+        return dynamic_detail::repair<Heap>(g, src, res, updates, &in_edges, scratch);
+    }
+
+    // Full Dijkstra from scratch on the current graph
+    void recompute() { res = dijkstra<Heap>(g, src); }
+
+    const Result& result() const { return res; }
+    Vertex source() const { return src; }
+
+private:
+    G& g;
+    Vertex src;
+    Result res;
+    std::vector<std::vector<dynamic_detail::InEdge<Vertex>>> in_edges;
+    dynamic_detail::RepairScratch<typename Heap::Handle, Vertex> scratch;
+};
@@ -3,29 +3,37 @@
 // Adapted from the implementation in main/fibonacci/fibonacci.cpp
 // Supports: insert (returns handle), extract-min, decrease-key, find-min
 // Includes built-in metrics tracking for benchmarking
+// Templated on key and vertex-id types; FibonacciHeap is the double/int default
 
+#include "trace.h"
+#include "latency_histogram.h"
+#include "heap_shape.h"
 #include <vector>
 #include <utility>
 #include <limits>
 #include <chrono>
 #include <algorithm>
 
-class FibonacciHeap {
+template<typename KeyT = double, typename VertexT = int>
+class BasicFibonacciHeap {
 public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
     struct Node {
-        double key;
-        int vertex;
+        Key key;
+        Vertex vertex;
         int degree;
+        bool mark; // kept beside degree so narrow keys pack into the pointer-aligned header
         Node* parent;
         Node* child;
         Node* left;
         Node* right;
-        bool mark;
 
-        Node(double k, int v)
-            : key(k), vertex(v), degree(0),
+        Node(Key k, Vertex v)
+            : key(k), vertex(v), degree(0), mark(false),
               parent(nullptr), child(nullptr),
-              left(this), right(this), mark(false) {}
+              left(this), right(this) {}
     };
 
     using Handle = Node;
@@ -36,15 +44,17 @@ public:
     int decrease_key_count = 0;
     double extract_min_time_ns = 0;
     double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+    using ShapeStats = FibonacciShapeStats;
+    ShapeStats* shape_stats = nullptr; // optional shape telemetry (heap_shape.h)
 
-    FibonacciHeap() : min_node(nullptr), n(0) {}
+    BasicFibonacciHeap() : min_node(nullptr), n(0) {}
 
-    ~FibonacciHeap() {
-        if (min_node) delete_all(min_node);
-    }
+    ~BasicFibonacciHeap() { clear(); }
 
     // Insert a vertex with given priority; returns a handle for decrease-key
-    Handle* insert(int vertex, double priority) {
+    Handle* insert(Vertex vertex, Key priority) {
         insert_count++;
         Node* node = new Node(priority, vertex);
         if (min_node == nullptr) {
@@ -62,14 +72,56 @@ public:
         return node;
     }
 
+    // Bulk-load (vertex, priority) pairs by splicing them into the root list as
+    // one circular chain in O(n); returns the handles in the same order as items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        if (items.empty()) return handles;
+
+        Node* first = nullptr;
+        Node* last = nullptr;
+        Node* chain_min = nullptr;
+        for (const auto& [vertex, priority] : items) {
+            Node* node = new Node(priority, vertex);
+            if (!first) {
+                first = node;
+            } else {
+                last->right = node;
+                node->left = last;
+            }
+            last = node;
+            if (!chain_min || node->key < chain_min->key)
+                chain_min = node;
+            handles.push_back(node);
+        }
+
+        if (!min_node) {
+            first->left = last;
+            last->right = first;
+            min_node = chain_min;
+        } else {
+            // Splice the chain in to the left of min
+            first->left = min_node->left;
+            min_node->left->right = first;
+            last->right = min_node;
+            min_node->left = last;
+            if (chain_min->key < min_node->key)
+                min_node = chain_min;
+        }
+        n += static_cast<int>(items.size());
+        return handles;
+    }
+
     // Remove and return the minimum element as (vertex, priority)
-    std::pair<int, double> extract_min() {
+    std::pair<Vertex, Key> extract_min() {
         auto start = std::chrono::high_resolution_clock::now();
         extract_min_count++;
 
         Node* z = min_node;
-        int vertex = z->vertex;
-        double key = z->key;
+        Vertex vertex = z->vertex;
+        Key key = z->key;
 
         // Promote all children to root list
         if (z->child) {
@@ -103,12 +155,14 @@ public:
         auto end = std::chrono::high_resolution_clock::now();
         extract_min_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
 
         return {vertex, key};
     }
 
     // Decrease the priority of a previously inserted node
-    void decrease_key(Handle* node, double new_key) {
+    void decrease_key(Handle* node, Key new_key) {
         auto start = std::chrono::high_resolution_clock::now();
         decrease_key_count++;
 
@@ -116,6 +170,8 @@ public:
             auto end = std::chrono::high_resolution_clock::now();
             decrease_key_time_ns += static_cast<double>(
                 std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
             return;
         }
 
@@ -124,6 +180,7 @@ public:
 
         if (parent && node->key < parent->key) {
             cut(node, parent);
+            if (shape_stats) shape_stats->cuts++;
             cascading_cut(parent);
         }
 
@@ -133,21 +190,32 @@ public:
         auto end = std::chrono::high_resolution_clock::now();
         decrease_key_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
     }
 
     bool empty() const { return min_node == nullptr; }
     int size() const { return n; }
 
-    std::pair<int, double> find_min() const {
+    std::pair<Vertex, Key> find_min() const {
         return {min_node->vertex, min_node->key};
     }
 
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        if (min_node) delete_all(min_node);
+        min_node = nullptr;
+        n = 0;
+    }
+
     void reset_metrics() {
         insert_count = 0;
         extract_min_count = 0;
         decrease_key_count = 0;
         extract_min_time_ns = 0;
         decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
     }
 
     static const char* name() { return "FibonacciHeap"; }
@@ -167,6 +235,7 @@ private:
             roots.push_back(curr);
             curr = curr->right;
         } while (curr != min_node);
+        if (shape_stats) shape_stats->root_list.add(roots.size());
 
         for (Node* w : roots) {
             int d = w->degree;
@@ -219,6 +288,10 @@ private:
         }
         parent->degree++;
         child->mark = false;
+        if (shape_stats) {
+            shape_stats->links++;
+            shape_stats->max_degree = std::max(shape_stats->max_degree, parent->degree);
+        }
     }
 
     void cut(Node* child, Node* parent) {
@@ -248,6 +321,7 @@ private:
                 node->mark = true;
             } else {
                 cut(node, parent);
+                if (shape_stats) shape_stats->cascading_cuts++;
                 cascading_cut(parent);
             }
         }
@@ -265,3 +339,5 @@ private:
         }
     }
 };
+
+using FibonacciHeap = BasicFibonacciHeap<>;
@@ -1,34 +1,93 @@
 #pragma once
+// Adjacency-list graph, templated on weight and id types:
+//   Weight - edge weight and search key type (double, float, uint32_t, uint64_t)
+//   Vertex - vertex id type (int, uint32_t, int64_t, ...)
+//   EdgeId - edge count type; 64-bit by default so graphs past 2^31 edges don't overflow
+// Graph / Edge are the double/int defaults used throughout.
+
 #include <vector>
 #include <utility>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+
+// Key for unreached vertices: +inf for floating-point weights, max() for integers
+template<typename Weight>
+constexpr Weight infinite_weight() {
+    return std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity()
+                                                     : std::numeric_limits<Weight>::max();
+}
+
+// "No vertex" parent sentinel: -1 for signed ids, max() for unsigned ones
+template<typename Vertex>
+constexpr Vertex no_vertex() { return static_cast<Vertex>(-1); }
 
-struct Edge {
-    int to;
-    double weight;
+template<typename Weight, typename Vertex>
+struct BasicEdge {
+    Vertex to;
+    Weight weight;
 };
 
-class Graph {
+template<typename WeightT = double, typename VertexT = int, typename EdgeIdT = std::uint64_t>
+class BasicGraph {
 public:
-    int num_vertices;
+    using Weight = WeightT;
+    using Vertex = VertexT;
+    using EdgeId = EdgeIdT;
+    using Edge = BasicEdge<Weight, Vertex>;
+
+    Vertex num_vertices;
     std::vector<std::vector<Edge>> adj;
 
-    Graph(int n) : num_vertices(n), adj(n) {}
+    BasicGraph(Vertex n) : num_vertices(n), adj(static_cast<std::size_t>(n)) {}
 
-    void add_edge(int from, int to, double weight) {
+    void add_edge(Vertex from, Vertex to, Weight weight) {
         adj[from].push_back({to, weight});
     }
 
-    void add_undirected_edge(int from, int to, double weight) {
+    void add_undirected_edge(Vertex from, Vertex to, Weight weight) {
         adj[from].push_back({to, weight});
         adj[to].push_back({from, weight});
     }
 
-    int size() const { return num_vertices; }
+    Vertex size() const { return num_vertices; }
 
-    int edge_count() const {
-        int count = 0;
+    EdgeId edge_count() const {
+        EdgeId count = 0;
         for (const auto& edges : adj)
-            count += static_cast<int>(edges.size());
+            count += static_cast<EdgeId>(edges.size());
         return count;
     }
+
+    // Bytes held by the adjacency lists (edge storage plus per-vertex vectors)
+    std::size_t memory_bytes() const {
+        std::size_t bytes = adj.capacity() * sizeof(std::vector<Edge>);
+        for (const auto& edges : adj)
+            bytes += edges.capacity() * sizeof(Edge);
+        return bytes;
+    }
 };
+
+using Edge = BasicEdge<double, int>;
+using Graph = BasicGraph<>;
+
+// Copy a graph into different weight / id types. Integer weight types round
+// to the nearest integer (generator weights are in [1, 100], so none become 0).
+template<typename To, typename From>
+To convert_graph(const From& g) {
+    using W = typename To::Weight;
+    using V = typename To::Vertex;
+    To out(static_cast<V>(g.size()));
+    for (std::size_t u = 0; u < g.adj.size(); u++) {
+        auto& edges = out.adj[u];
+        edges.reserve(g.adj[u].size());
+        for (const auto& e : g.adj[u]) {
+            W w = std::is_integral<W>::value ? static_cast<W>(std::llround(e.weight))
+                                             : static_cast<W>(e.weight);
+            edges.push_back({static_cast<V>(e.to), w});
+        }
+    }
+    return out;
+}
@@ -0,0 +1,330 @@
+#pragma once
+// Persistent on-disk cache of generated benchmark graphs
+// GraphGenerator routes each generator call through GraphCache::global().
+// Until open(dir) is called the cache only times generation; once open, a
+// graph is looked up by its key - generator name, parameters, seed and
+// GraphGenerator::version - and loaded from disk instead of regenerated.
+// Misses are generated, then stored for the next run. print_report() lists
+// generation times either way, plus load / store times when open. Bump
+// GraphGenerator::version whenever a generator's output changes, so stale
+// files are never loaded (they are simply no longer looked up).
+// File format (host byte order; "<name>_<hash of key>.graph"):
+//   magic "GRAPHC02", u32 key length, key bytes, u64 V, u64 edge entries,
+//   f64 original generation time (ms), u64 payload checksum,
+//   u32 degree[V], i32 target[E], f64 weight[E]
+// Edge order is preserved exactly, so searches on a loaded graph match a
+// freshly generated one bit for bit. A file whose key, magic, size or
+// checksum doesn't match is ignored and rewritten. Writes go to a temporary
+// file unique to the process and call, which is then renamed, so neither an
+// interrupted run nor two runs storing the same graph leave a bad entry.
+
+#include "graph.h"
+#include "trace.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <filesystem>
+#include <system_error>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <unistd.h>
+#else
+#include <random>
+#endif
+
+struct GraphCacheKey {
+    std::string generator;      // e.g. "grid_graph"
+    std::vector<double> params; // generator arguments other than the seed
+    int seed = 42;
+    int version = 1;            // GraphGenerator::version
+
+    std::string str() const {
+        std::ostringstream os;
+        os << generator << "(";
+        for (std::size_t i = 0; i < params.size(); i++) {
+            // Shortest precision that round-trips, so 4.0 / 1000 prints as 0.004
+            std::ostringstream p;
+            for (int digits = 6; digits <= 17; digits++) {
+                p.str("");
+                p << std::setprecision(digits) << params[i];
+                if (std::stod(p.str()) == params[i]) break;
+            }
+            os << (i ? "," : "") << p.str();
+        }
+        os << ") seed=" << seed << " v" << version;
+        return os.str();
+    }
+};
+
+// One generator call, for the generation-vs-load report
+struct GraphCacheEntry {
+    std::string key;
+    long long vertices = 0;
+    std::uint64_t edges = 0;
+    bool loaded = false;     // true: read from disk; false: generated
+    double generate_ms = 0;  // this run's generation, or the original one for a hit
+    double load_ms = 0;
+    double store_ms = 0;
+    std::uintmax_t file_bytes = 0;
+};
+
+class GraphCache {
+public:
+    static GraphCache& global() {
+        static GraphCache cache;
+        return cache;
+    }
+
+    // Start persisting under dir (created if missing); on failure the cache stays off
+    void open(const std::string& dir) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        std::lock_guard<std::mutex> lock(mutex);
+        directory = ec ? "" : dir;
+        if (ec) std::cerr << "Graph cache disabled: can't create " << dir << " (" << ec.message() << ")\n";
+    }
+
+    bool enabled() const { return !directory.empty(); }
+
+    template<typename Generate>
+    Graph get(const GraphCacheKey& key, Generate generate) {
+        using clock = std::chrono::high_resolution_clock;
+        GraphCacheEntry entry;
+        entry.key = key.str();
+        std::string path = enabled() ? file_path(key, entry.key) : "";
+
+        if (!path.empty()) {
+            trace::Zone zone("load graph", "graph");
+            auto start = clock::now();
+            Graph g(0);
+            if (load(g, path, entry.key, entry.generate_ms)) {
+                entry.loaded = true;
+                entry.load_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+                finish(entry, g, path);
+                return g;
+            }
+        }
+
+        auto start = clock::now();
+        Graph g = generate();
+        entry.generate_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if (!path.empty()) {
+            trace::Zone zone("store graph", "graph");
+            auto stored = clock::now();
+            if (store(g, path, entry.key, entry.generate_ms))
+                entry.store_ms = std::chrono::duration<double, std::milli>(clock::now() - stored).count();
+        }
+        finish(entry, g, path);
+        return g;
+    }
+
+    std::vector<GraphCacheEntry> entries() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return log;
+    }
+
+    // Generation time for every graph requested so far; with the cache open,
+    // also where each came from and its load / store time and file size
+    void print_report(std::ostream& out = std::cout) const {
+        auto rows = entries();
+        if (rows.empty()) return;
+        const bool cached = enabled();
+        if (cached)
+            out << "\n========== GRAPH CACHE (" << directory << ") ==========\n\n";
+        else
+            out << "\n========== GRAPH GENERATION ==========\n\n";
+        out << std::left << std::setw(50) << "Graph" << std::setw(10) << "|V|" << std::setw(11) << "|E|";
+        if (cached) out << std::setw(8) << "Source";
+        out << std::setw(11) << "Gen(ms)";
+        if (cached) out << std::setw(11) << "Load(ms)" << std::setw(11) << "Store(ms)" << "File(MB)";
+        out << "\n" << std::string(cached ? 120 : 82, '-') << "\n";
+        double generated = 0, loaded = 0, saved = 0;
+        for (const auto& e : rows) {
+            out << std::left << std::setw(50) << e.key << std::setw(10) << e.vertices << std::setw(11) << e.edges;
+            if (cached) out << std::setw(8) << (e.loaded ? "disk" : "gen");
+            out << std::fixed << std::setprecision(1) << std::setw(11) << e.generate_ms;
+            if (cached) out << std::setw(11) << e.load_ms << std::setw(11) << e.store_ms << e.file_bytes / 1e6;
+            out << "\n";
+            if (e.loaded) {
+                loaded += e.load_ms;
+                saved += e.generate_ms - e.load_ms;
+            } else {
+                generated += e.generate_ms;
+            }
+        }
+        out << "\nGenerated " << generated << " ms";
+        if (cached) out << ", loaded " << loaded << " ms; cache hits saved " << saved << " ms of generation";
+        out << "\n";
+    }
+
+    static bool store(const Graph& g, const std::string& path, const std::string& key, double generate_ms) {
+        std::string tmp = temp_path(path);
+        {
+            std::ofstream out(tmp, std::ios::binary);
+            if (!out) return false;
+            const std::uint64_t n = g.adj.size(), m = g.edge_count();
+            std::vector<std::uint32_t> degree(n);
+            std::vector<std::int32_t> target;
+            std::vector<double> weight;
+            target.reserve(m);
+            weight.reserve(m);
+            for (std::size_t u = 0; u < n; u++) {
+                degree[u] = static_cast<std::uint32_t>(g.adj[u].size());
+                for (const auto& e : g.adj[u]) {
+                    target.push_back(static_cast<std::int32_t>(e.to));
+                    weight.push_back(e.weight);
+                }
+            }
+            const std::uint32_t key_len = static_cast<std::uint32_t>(key.size());
+            out.write(magic, sizeof(magic));
+            write(out, key_len);
+            out.write(key.data(), key_len);
+            write(out, n);
+            write(out, m);
+            write(out, generate_ms);
+            write(out, payload_checksum(degree, target, weight));
+            out.write(reinterpret_cast<const char*>(degree.data()), n * sizeof(std::uint32_t));
+            out.write(reinterpret_cast<const char*>(target.data()), m * sizeof(std::int32_t));
+            out.write(reinterpret_cast<const char*>(weight.data()), m * sizeof(double));
+            if (!out) {
+                out.close();
+                std::remove(tmp.c_str());
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) std::remove(tmp.c_str());
+        return !ec;
+    }
+
+    static bool load(Graph& g, const std::string& path, const std::string& key, double& generate_ms) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        char file_magic[sizeof(magic)];
+        std::uint32_t key_len = 0;
+        if (!in.read(file_magic, sizeof(file_magic)) || std::memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+            !read(in, key_len) || key_len != key.size())
+            return false;
+        std::string file_key(key_len, '\0');
+        std::uint64_t n = 0, m = 0, sum = 0;
+        if (!in.read(&file_key[0], key_len) || file_key != key || !read(in, n) || !read(in, m) ||
+            !read(in, generate_ms) || !read(in, sum))
+            return false;
+
+        // Check the size before allocating, so a damaged header can't request gigabytes
+        std::error_code ec;
+        std::uintmax_t expected = sizeof(magic) + sizeof(key_len) + key_len + 2 * sizeof(std::uint64_t) +
+                                  sizeof(double) + sizeof(sum) + n * sizeof(std::uint32_t) +
+                                  m * (sizeof(std::int32_t) + sizeof(double));
+        if (std::filesystem::file_size(path, ec) != expected || ec) return false;
+
+        std::vector<std::uint32_t> degree(n);
+        std::vector<std::int32_t> target(m);
+        std::vector<double> weight(m);
+        in.read(reinterpret_cast<char*>(degree.data()), n * sizeof(std::uint32_t));
+        in.read(reinterpret_cast<char*>(target.data()), m * sizeof(std::int32_t));
+        in.read(reinterpret_cast<char*>(weight.data()), m * sizeof(double));
+        if (!in || payload_checksum(degree, target, weight) != sum) return false;
+
+        Graph out(static_cast<int>(n));
+        std::uint64_t next = 0;
+        for (std::size_t u = 0; u < n; u++) {
+            if (next + degree[u] > m) return false;
+            auto& edges = out.adj[u];
+            edges.resize(degree[u]);
+            for (auto& e : edges) {
+                e = {target[next], weight[next]};
+                next++;
+            }
+        }
+        if (next != m) return false;
+        g = std::move(out);
+        return true;
+    }
+
+private:
+    static constexpr char magic[8] = {'G', 'R', 'A', 'P', 'H', 'C', '0', '2'};
+
+    mutable std::mutex mutex;
+    std::string directory;
+    std::vector<GraphCacheEntry> log;
+
+    // "<path>.<pid>.<n>.tmp": concurrent stores of one graph, from threads or
+    // separate runs sharing the directory, never write the same file
+    static std::string temp_path(const std::string& path) {
+        static std::atomic<unsigned> counter{0};
+#if defined(__linux__)
+        long pid = static_cast<long>(::getpid());
+#else
+        static const long pid = static_cast<long>(std::random_device{}() & 0x7fffffff);
+#endif
+        return path + "." + std::to_string(pid) + "." + std::to_string(counter.fetch_add(1)) + ".tmp";
+    }
+
+    // FNV-1a over 64-bit words in four interleaved lanes (a multiply chain per
+    // lane keeps the hash at memory speed), then the tail bytes
+    static void checksum_bytes(std::uint64_t (&lane)[4], const void* data, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            for (int k = 0; k < 4; k++) {
+                std::uint64_t w;
+                std::memcpy(&w, p + i + 8 * k, sizeof(w));
+                lane[k] = (lane[k] ^ w) * 1099511628211ull;
+            }
+        }
+        for (; i < bytes; i++) lane[0] = (lane[0] ^ p[i]) * 1099511628211ull;
+    }
+
+    static std::uint64_t payload_checksum(const std::vector<std::uint32_t>& degree,
+                                          const std::vector<std::int32_t>& target,
+                                          const std::vector<double>& weight) {
+        std::uint64_t lane[4] = {1469598103934665603ull, 1469598103934665603ull ^ 1,
+                                 1469598103934665603ull ^ 2, 1469598103934665603ull ^ 3};
+        checksum_bytes(lane, degree.data(), degree.size() * sizeof(std::uint32_t));
+        checksum_bytes(lane, target.data(), target.size() * sizeof(std::int32_t));
+        checksum_bytes(lane, weight.data(), weight.size() * sizeof(double));
+        std::uint64_t h = lane[0];
+        for (int k = 1; k < 4; k++) h = (h ^ lane[k]) * 1099511628211ull;
+        return h;
+    }
+
+    std::string file_path(const GraphCacheKey& key, const std::string& key_str) const {
+        std::uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (unsigned char c : key_str) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+        return (std::filesystem::path(directory) / (key.generator + "_" + hex + ".graph")).string();
+    }
+
+    void finish(GraphCacheEntry& entry, const Graph& g, const std::string& path) {
+        entry.vertices = g.size();
+        entry.edges = g.edge_count();
+        std::error_code ec;
+        if (!path.empty()) entry.file_bytes = std::filesystem::file_size(path, ec);
+        if (ec) entry.file_bytes = 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        log.push_back(std::move(entry));
+    }
+
+    template<typename T>
+    static void write(std::ostream& out, const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    template<typename T>
+    static bool read(std::istream& in, T& v) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T)));
+    }
+};
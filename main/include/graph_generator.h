@@ -1,13 +1,73 @@
 #pragma once
 #include "graph.h"
+#include "trace.h"
+#include "graph_cache.h"
 #include <random>
 #include <algorithm>
 #include <cmath>
+#include <vector>
+#include <utility>
 
+// Every generator goes through GraphCache::global() (graph_cache.h): timed
+// always, and loaded from disk instead of regenerated once the cache is open
 class GraphGenerator {
 public:
+    // Part of every cache key; bump when any generator's output changes
+    static constexpr int version = 1;
+
     // Erdos-Renyi random graph with given edge probability
     static Graph random_graph(int n, double edge_probability, int seed = 42) {
+        return cached("random_graph", {static_cast<double>(n), edge_probability}, seed,
+                      [&] { return build_random_graph(n, edge_probability, seed); });
+    }
+
+    // Sparse random graph: ~4 edges per vertex on average
+    static Graph sparse_random(int n, int seed = 42) {
+        double p = 4.0 / n;
+        return random_graph(n, p, seed);
+    }
+
+    // Sparse random graph in O(V + E): n * avg_degree / 2 edges between
+    // uniformly random endpoints (self-loops skipped, parallel edges possible),
+    // for sizes where random_graph's O(V^2) pair loop is too slow
+    static Graph sparse_random_edges(int n, int avg_degree = 4, int seed = 42) {
+        return cached("sparse_random_edges", {static_cast<double>(n), static_cast<double>(avg_degree)}, seed,
+                      [&] { return build_sparse_random_edges(n, avg_degree, seed); });
+    }
+
+    // Dense random graph: ~50% of all possible edges present
+    static Graph dense_random(int n, int seed = 42) {
+        double p = 0.5;
+        return random_graph(n, p, seed);
+    }
+
+    // 2D grid graph (rows x cols)
+    static Graph grid_graph(int rows, int cols, int seed = 42) {
+        return cached("grid_graph", {static_cast<double>(rows), static_cast<double>(cols)}, seed,
+                      [&] { return build_grid_graph(rows, cols, seed); });
+    }
+
+    // Worst-case graph: designed to force many decrease-key operations
+    // Chain backbone + high-weight shortcuts from source that get improved
+    static Graph worst_case_graph(int n, int seed = 42) {
+        return cached("worst_case_graph", {static_cast<double>(n)}, seed,
+                      [&] { return build_worst_case_graph(n, seed); });
+    }
+
+    // Complete graph (all pairs connected)
+    static Graph complete_graph(int n, int seed = 42) {
+        return cached("complete_graph", {static_cast<double>(n)}, seed,
+                      [&] { return build_complete_graph(n, seed); });
+    }
+
+private:
+    template<typename Build>
+    static Graph cached(const char* generator, std::vector<double> params, int seed, Build build) {
+        return GraphCache::global().get({generator, std::move(params), seed, version}, build);
+    }
+
+    static Graph build_random_graph(int n, double edge_probability, int seed) {
+        trace::Zone zone("random_graph", "graph");
         Graph g(n);
         std::mt19937 rng(seed);
         std::uniform_real_distribution<double> prob(0.0, 1.0);
@@ -25,20 +85,24 @@ public:
         return g;
     }
 
-    // Sparse random graph: ~4 edges per vertex on average
-    static Graph sparse_random(int n, int seed = 42) {
-        double p = 4.0 / n;
-        return random_graph(n, p, seed);
-    }
+    static Graph build_sparse_random_edges(int n, int avg_degree, int seed) {
+        trace::Zone zone("sparse_random_edges", "graph");
+        Graph g(n);
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, std::max(n - 1, 0));
+        std::uniform_real_distribution<double> weight(1.0, 100.0);
 
-    // Dense random graph: ~50% of all possible edges present
-    static Graph dense_random(int n, int seed = 42) {
-        double p = 0.5;
-        return random_graph(n, p, seed);
+        long long edges = static_cast<long long>(n) * avg_degree / 2;
+        for (long long i = 0; i < edges; i++) {
+            int u = vertex(rng), v = vertex(rng);
+            if (u != v) g.add_undirected_edge(u, v, weight(rng));
+        }
+        ensure_connected(g, rng, weight);
+        return g;
     }
 
-    // 2D grid graph (rows x cols)
-    static Graph grid_graph(int rows, int cols, int seed = 42) {
+    static Graph build_grid_graph(int rows, int cols, int seed) {
+        trace::Zone zone("grid_graph", "graph");
         int n = rows * cols;
         Graph g(n);
         std::mt19937 rng(seed);
@@ -56,9 +120,8 @@ public:
         return g;
     }
 
-    // Worst-case graph: designed to force many decrease-key operations
-    // Chain backbone + high-weight shortcuts from source that get improved
-    static Graph worst_case_graph(int n, int seed = 42) {
+    static Graph build_worst_case_graph(int n, int seed) {
+        trace::Zone zone("worst_case_graph", "graph");
         Graph g(n);
         std::mt19937 rng(seed);
         std::uniform_real_distribution<double> weight(50.0, 100.0);
@@ -84,8 +147,8 @@ public:
         return g;
     }
 
-    // Complete graph (all pairs connected)
-    static Graph complete_graph(int n, int seed = 42) {
+    static Graph build_complete_graph(int n, int seed) {
+        trace::Zone zone("complete_graph", "graph");
         Graph g(n);
         std::mt19937 rng(seed);
         std::uniform_real_distribution<double> weight(1.0, 100.0);
@@ -96,7 +159,6 @@ public:
         return g;
     }
 
-private:
     // Ensure graph is connected by adding spanning-path edges where missing
     static void ensure_connected(Graph& g, std::mt19937& rng,
                                   std::uniform_real_distribution<double>& weight) {
@@ -0,0 +1,50 @@
+#pragma once
+// Optional shape telemetry for the Fibonacci, pairing and binary heaps
+// Each heap has a `shape_stats` pointer (ShapeStats type alias), null by
+// default, so a normal run pays one predictable branch per event. Point it
+// at a stats object to count what the heap's structure does:
+//   FibonacciShapeStats - root-list length at each consolidate, links, cuts
+//                         and cascading cuts, largest degree
+//   PairingShapeStats   - child-list length at extract-min, sibling-scan
+//                         length to detach a node in decrease-key, and the
+//                         node's depth (walked before the op timing starts)
+//   BinaryShapeStats    - levels moved by each sift-up / sift-down
+// Benchmark::run_dijkstra_shape<Heap>(g, ..., stats) runs a search with it set.
+
+#include <algorithm>
+#include <cstdint>
+
+// Count, sum and max of one per-event quantity
+struct ShapeCounter {
+    std::uint64_t events = 0;
+    std::uint64_t total = 0;
+    std::uint64_t max = 0;
+
+    void add(std::uint64_t value) {
+        events++;
+        total += value;
+        max = std::max(max, value);
+    }
+    double mean() const { return events ? static_cast<double>(total) / events : 0.0; }
+};
+
+struct FibonacciShapeStats {
+    ShapeCounter root_list;          // roots scanned per consolidate
+    std::uint64_t links = 0;         // trees linked during consolidation
+    std::uint64_t cuts = 0;          // nodes cut by decrease-key itself
+    std::uint64_t cascading_cuts = 0; // marked ancestors cut afterwards
+    int max_degree = 0;
+};
+
+struct PairingShapeStats {
+    ShapeCounter children;      // root's child-list length at extract-min
+    ShapeCounter sibling_scan;  // siblings walked to detach a non-leftmost child
+    ShapeCounter depth;         // depth of the node at decrease-key (root = 0)
+    std::uint64_t leftmost_detaches = 0; // detached without a scan
+};
+
+struct BinaryShapeStats {
+    ShapeCounter insert_up;     // levels moved by sift-up on insert
+    ShapeCounter decrease_up;   // ... on decrease-key
+    ShapeCounter extract_down;  // levels moved by sift-down on extract-min
+};
@@ -0,0 +1,245 @@
+#pragma once
+// Synthetic priority-queue workloads and crossover search
+// Drives a heap directly, without a graph, with a parameterized operation
+// stream in the hold model: the queue is filled with queue_size entries, then
+// each round does `decrease_ratio` decrease-keys on random live entries
+// (fractional ratios are spread over rounds), one extract-min and one insert
+// that puts the extracted id back with a new key. Keys never drop below the
+// last extracted key, as in Dijkstra; new keys are last_min + a draw from
+// the key distribution, and a decrease-key moves an entry's key
+// decrease_fraction of the way down to last_min.
+// Random draws are generated in untimed chunks, so the time per operation is
+// heap work only. Operation counts up to 10^8 run in bounded memory.
+//   run_workload<Heap>(spec)                    - ns per operation
+//   median_ns_per_op(runs)                      - median over repeated runs
+//   find_crossovers<HeapA, HeapB>(base, axis, ...) - parameter values where
+//                                                 the faster heap changes
+
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+enum class KeyDistribution {
+    Uniform,     // last_min + U(0, key_spread)
+    Exponential, // last_min + Exp(mean key_spread / 8): most new keys near the front
+    Clustered    // last_min + one of 16 levels: many equal keys
+};
+
+inline const char* key_distribution_name(KeyDistribution d) {
+    switch (d) {
+    case KeyDistribution::Uniform: return "uniform";
+    case KeyDistribution::Exponential: return "exponential";
+    case KeyDistribution::Clustered: return "clustered";
+    }
+    return "?";
+}
+
+struct WorkloadSpec {
+    std::size_t queue_size = 100000;
+    double decrease_ratio = 1.0;    // decrease-keys per extract-min
+    double decrease_fraction = 0.5; // share of (key - last_min) removed by a decrease-key, (0, 1]; at 1
+                                    // every lowered key ties at last_min (zero-weight edges)
+    KeyDistribution keys = KeyDistribution::Uniform;
+    double key_spread = 1e6;
+    std::uint64_t operations = 2000000; // timed operations (fill excluded)
+    unsigned seed = 42;
+};
+
+struct WorkloadResult {
+    double ns_per_op = 0;
+    std::uint64_t inserts = 0;
+    std::uint64_t extracts = 0;
+    std::uint64_t decrease_keys = 0;
+    double checksum = 0; // sum of extracted keys; equal across heaps for the same
+                         // spec unless keys tie (Clustered), where order may differ
+};
+
+namespace workload_detail {
+
+// One chunk of pre-drawn randomness
+struct Draws {
+    std::vector<std::uint32_t> slot; // decrease-key targets
+    std::vector<double> key;         // new-key offsets
+};
+
+inline double draw_key(KeyDistribution dist, double spread, std::mt19937_64& rng) {
+    switch (dist) {
+    case KeyDistribution::Exponential:
+        return std::exponential_distribution<double>(8.0 / spread)(rng);
+    case KeyDistribution::Clustered:
+        return spread / 16.0 * static_cast<double>(rng() % 16);
+    case KeyDistribution::Uniform:
+    default:
+        return std::uniform_real_distribution<double>(0.0, spread)(rng);
+    }
+}
+
+} // namespace workload_detail
+
+template<typename Heap>
+WorkloadResult run_workload(const WorkloadSpec& spec) {
+    using Key = typename Heap::Key;
+    using Vertex = typename Heap::Vertex;
+    using Handle = typename Heap::Handle;
+    const std::size_t n = std::max<std::size_t>(spec.queue_size, 1);
+    const std::size_t chunk = 1 << 16;
+
+    std::mt19937_64 rng(spec.seed);
+    Heap heap;
+    std::vector<Handle*> handle(n);
+    std::vector<Key> key(n); // shadow of each entry's key
+    for (std::size_t i = 0; i < n; i++) {
+        key[i] = static_cast<Key>(workload_detail::draw_key(spec.keys, spec.key_spread, rng));
+        handle[i] = heap.insert(static_cast<Vertex>(i), key[i]);
+    }
+
+    WorkloadResult res;
+    workload_detail::Draws draws;
+    Key last_min = Key(0);
+    double credit = 0; // accumulated fractional decrease-keys
+    const double keep = 1.0 - std::min(std::max(spec.decrease_fraction, 0.0), 1.0);
+    double seconds = 0;
+    std::uint64_t done = 0;
+
+    while (done < spec.operations) {
+        // Untimed: draw enough randomness for the next chunk of rounds
+        const double per_round = spec.decrease_ratio + 2.0;
+        std::size_t rounds = std::max<std::size_t>(1, static_cast<std::size_t>(chunk / per_round));
+        std::size_t decreases = static_cast<std::size_t>(std::ceil(spec.decrease_ratio * rounds + 1));
+        draws.slot.resize(decreases);
+        draws.key.resize(rounds);
+        for (auto& s : draws.slot) s = static_cast<std::uint32_t>(rng() % n);
+        for (auto& k : draws.key) k = workload_detail::draw_key(spec.keys, spec.key_spread, rng);
+
+        std::size_t next_slot = 0;
+        std::uint64_t ops = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t r = 0; r < rounds && done + ops < spec.operations; r++) {
+            credit += spec.decrease_ratio;
+            while (credit >= 1.0 && next_slot < draws.slot.size()) {
+                credit -= 1.0;
+                std::uint32_t s = draws.slot[next_slot++];
+                Key lowered = static_cast<Key>(last_min + (key[s] - last_min) * keep);
+                if (lowered < key[s]) { // entries already at last_min can't drop further
+                    key[s] = lowered;
+                    heap.decrease_key(handle[s], lowered);
+                    res.decrease_keys++;
+                    ops++;
+                }
+            }
+            auto [v, k] = heap.extract_min();
+            last_min = k;
+            res.checksum += static_cast<double>(k);
+            key[v] = static_cast<Key>(k + draws.key[r]);
+            handle[v] = heap.insert(v, key[v]);
+            res.extracts++;
+            res.inserts++;
+            ops += 2;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        seconds += std::chrono::duration<double>(end - start).count();
+        done += ops;
+    }
+
+    res.ns_per_op = done ? seconds * 1e9 / static_cast<double>(done) : 0.0;
+    return res;
+}
+
+// Median of repeated ns_per_op measurements (mean of the middle two if even)
+inline double median_ns_per_op(std::vector<double> runs) {
+    if (runs.empty()) return 0.0;
+    std::sort(runs.begin(), runs.end());
+    std::size_t mid = runs.size() / 2;
+    return runs.size() % 2 ? runs[mid] : (runs[mid - 1] + runs[mid]) / 2;
+}
+
+// A parameter of WorkloadSpec swept on a log scale
+struct WorkloadAxis {
+    std::string name;
+    double lo, hi;
+    std::function<void(WorkloadSpec&, double)> set;
+};
+
+inline std::vector<WorkloadAxis> default_workload_axes() {
+    return {
+        {"queue_size", 1e3, 1e7, [](WorkloadSpec& s, double x) { s.queue_size = static_cast<std::size_t>(x); }},
+        {"decrease_ratio", 1.0 / 16, 64, [](WorkloadSpec& s, double x) { s.decrease_ratio = x; }},
+        {"decrease_fraction", 1e-3, 0.9, [](WorkloadSpec& s, double x) { s.decrease_fraction = x; }},
+    };
+}
+
+struct Crossover {
+    std::string axis;
+    double at;                 // parameter value where the two heaps tie
+    std::string faster_below;  // heap name winning at smaller values
+    std::string faster_above;
+};
+
+// Sample `points` log-spaced values of axis (others as in base); wherever the
+// faster of HeapA / HeapB changes between neighbours, bisect `refine` times
+// on the log scale. Each comparison runs `repeats` rounds, one run per heap
+// per round with the order alternating, and compares the medians. A heap
+// counts as faster only if the medians differ by at least `margin`
+// (relative) and it won every round; anything else is a tie. A crossing is
+// therefore only reported between points whose winner held in every round,
+// so timing noise between near-equal heaps doesn't produce spurious ones.
+template<typename HeapA, typename HeapB>
+std::vector<Crossover> find_crossovers(const WorkloadSpec& base, const WorkloadAxis& axis,
+                                       int points = 7, int refine = 4, double margin = 0.05,
+                                       int repeats = 5) {
+    auto diff = [&](double x) { // > 0: HeapB faster
+        WorkloadSpec spec = base;
+        axis.set(spec, x);
+        std::vector<double> a, b;
+        for (int r = 0; r < repeats; r++) {
+            if (r % 2 == 0) {
+                a.push_back(run_workload<HeapA>(spec).ns_per_op);
+                b.push_back(run_workload<HeapB>(spec).ns_per_op);
+            } else {
+                b.push_back(run_workload<HeapB>(spec).ns_per_op);
+                a.push_back(run_workload<HeapA>(spec).ns_per_op);
+            }
+        }
+        double ma = median_ns_per_op(a), mb = median_ns_per_op(b);
+        double rel = (ma - mb) / std::min(ma, mb);
+        if (std::fabs(rel) < margin) return 0.0;
+        for (std::size_t r = 0; r < a.size(); r++)
+            if ((a[r] > b[r]) != (rel > 0)) return 0.0; // a round disagrees
+        return rel;
+    };
+
+    std::vector<double> xs, ds;
+    for (int i = 0; i < points; i++) {
+        double t = points > 1 ? static_cast<double>(i) / (points - 1) : 0.0;
+        xs.push_back(axis.lo * std::pow(axis.hi / axis.lo, t));
+        ds.push_back(diff(xs.back()));
+    }
+
+    std::vector<Crossover> out;
+    int last = -1; // index of the last sample with a clear winner
+    for (int i = 0; i < points; i++) {
+        if (ds[i] == 0.0) continue;
+        if (last >= 0 && (ds[last] > 0) != (ds[i] > 0)) {
+            double lo = xs[last], hi = xs[i];
+            bool lo_b_faster = ds[last] > 0;
+            for (int r = 0; r < refine; r++) {
+                double mid = std::sqrt(lo * hi);
+                double d = diff(mid);
+                if (d == 0.0) break;
+                if ((d > 0) == lo_b_faster) lo = mid;
+                else hi = mid;
+            }
+            out.push_back({axis.name, std::sqrt(lo * hi),
+                           lo_b_faster ? HeapB::name() : HeapA::name(),
+                           lo_b_faster ? HeapA::name() : HeapB::name()});
+        }
+        last = i;
+    }
+    return out;
+}
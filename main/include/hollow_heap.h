@@ -0,0 +1,308 @@
+#pragma once
+// Hollow Heap (Hansen, Kaplan, Tarjan & Zwick) for graph algorithms
+// Decrease-key never cuts subtrees: the item moves to a fresh node and the
+// old node is left behind "hollow" as a child of the new one (a node can
+// therefore have two parents). Hollow nodes are only cleaned up when
+// extract-min reaches them, using ranked links like a Fibonacci heap.
+// Two variants are provided:
+//   single-root: every insert/decrease-key links eagerly with the root
+//   multi-root:  new nodes are appended to a root list and linked lazily
+// Supports: insert (returns handle), extract-min, decrease-key, find-min
+// Includes built-in metrics tracking for benchmarking
+// Key and vertex-id types are trailing template parameters (default double/int)
+
+#include "trace.h"
+#include "latency_histogram.h"
+#include <vector>
+#include <utility>
+#include <chrono>
+
+template<bool MultiRoot, typename KeyT = double, typename VertexT = int>
+class HollowHeap {
+public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
+    struct Node;
+
+    // Handles point at items, since an item moves to a new node on decrease-key
+    struct Item {
+        Vertex vertex;
+        Node* node;
+
+        Item(Vertex v) : vertex(v), node(nullptr) {}
+    };
+
+    struct Node {
+        Key key;
+        Item* item;  // nullptr once the node is hollow
+        Node* child; // most recently linked child
+        Node* next;  // next sibling (or next root in the multi-root list)
+        Node* ep;    // extra (second) parent of a hollow node, if any
+        int rank;
+        bool is_root;
+
+        Node(Key k, Item* e)
+            : key(k), item(e), child(nullptr), next(nullptr), ep(nullptr),
+              rank(0), is_root(false) {
+            e->node = this;
+        }
+    };
+
+    using Handle = Item;
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0;
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    HollowHeap() : root(nullptr), root_list(nullptr), n(0) {}
+
+    ~HollowHeap() { clear(); }
+
+    HollowHeap(const HollowHeap&) = delete;
+    HollowHeap& operator=(const HollowHeap&) = delete;
+
+    // Insert a vertex with given priority; returns a handle for decrease-key
+    Handle* insert(Vertex vertex, Key priority) {
+        insert_count++;
+        Item* item = new Item(vertex);
+        add_root(new Node(priority, item));
+        n++;
+        return item;
+    }
+
+    // Bulk-load (vertex, priority) pairs in O(n): each node is one unranked
+    // link (single-root) or root-list append (multi-root) without per-call
+    // overhead. Returns the handles in the same order as items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        for (const auto& [vertex, priority] : items) {
+            Item* item = new Item(vertex);
+            add_root(new Node(priority, item));
+            handles.push_back(item);
+        }
+        n += static_cast<int>(items.size());
+        return handles;
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<Vertex, Key> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        Node* h = root;
+        Item* item = h->item;
+        Vertex vertex = item->vertex;
+        Key key = h->key;
+
+        h->item = nullptr;
+        delete item;
+        n--;
+
+        int max_rank = -1;
+
+        // Multi-root: the remaining full roots go straight into the rank table
+        if (MultiRoot) {
+            Node* r = root_list;
+            while (r) {
+                Node* next = r->next;
+                r->next = nullptr;
+                if (r != h) rank_insert(r, max_rank);
+                r = next;
+            }
+            root_list = nullptr;
+        }
+
+        // Destroy hollow nodes, collecting their full children by rank
+        h->next = nullptr;
+        while (h) {
+            Node* w = h->child;
+            Node* x = h;
+            h = h->next;
+            while (w) {
+                Node* u = w;
+                w = w->next;
+                if (!u->item) {
+                    if (!u->ep) {
+                        u->next = h;
+                        h = u;
+                    } else {
+                        // u is the last child of its extra parent; stop there,
+                        // otherwise leave u hanging under its extra parent only
+                        if (u->ep == x)
+                            w = nullptr;
+                        else
+                            u->next = nullptr;
+                        u->ep = nullptr;
+                    }
+                } else {
+                    u->next = nullptr;
+                    rank_insert(u, max_rank);
+                }
+            }
+            delete x;
+        }
+
+        // Combine survivors with unranked links
+        root = nullptr;
+        for (int i = 0; i <= max_rank; i++) {
+            if (rank_table[i]) {
+                add_root(rank_table[i]);
+                rank_table[i] = nullptr;
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {vertex, key};
+    }
+
+    // Decrease the priority of a previously inserted item
+    void decrease_key(Handle* item, Key new_key) {
+        auto start = std::chrono::high_resolution_clock::now();
+        decrease_key_count++;
+
+        Node* u = item->node;
+        if (new_key >= u->key) {
+            auto end = std::chrono::high_resolution_clock::now();
+            decrease_key_time_ns += static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
+            return;
+        }
+
+        if (u->is_root) {
+            // Roots are updated in place
+            u->key = new_key;
+            if (new_key < root->key)
+                root = u;
+        } else {
+            // Move the item to a new node; u stays behind as a hollow child
+            u->item = nullptr;
+            Node* v = new Node(new_key, item);
+            if (u->rank > 2) v->rank = u->rank - 2;
+            v->child = u;
+            u->ep = v;
+            add_root(v);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        decrease_key_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
+    }
+
+    bool empty() const { return root == nullptr; }
+    int size() const { return n; }
+
+    std::pair<Vertex, Key> find_min() const {
+        return {root->item->vertex, root->key};
+    }
+
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        delete_all();
+        root = nullptr;
+        root_list = nullptr;
+        n = 0;
+    }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return MultiRoot ? "HollowMulti" : "HollowSingle"; }
+
+private:
+    // Single-root: root is the only tree. Multi-root: root is the minimum
+    // of the root list, which is linked through next from root_list
+    Node* root;
+    Node* root_list;
+    int n;
+    std::vector<Node*> rank_table;
+
+    // Unranked link: the loser becomes the first child of the winner
+    static Node* link(Node* v, Node* w) {
+        if (v->key >= w->key) std::swap(v, w);
+        w->next = v->child;
+        w->is_root = false;
+        v->child = w;
+        return v;
+    }
+
+    // Ranked linking into the table (links only equal-rank trees)
+    void rank_insert(Node* u, int& max_rank) {
+        while (u->rank < static_cast<int>(rank_table.size()) && rank_table[u->rank]) {
+            int r = u->rank;
+            u = link(u, rank_table[r]);
+            rank_table[r] = nullptr;
+            u->rank = r + 1;
+        }
+        if (u->rank >= static_cast<int>(rank_table.size()))
+            rank_table.resize(u->rank + 1, nullptr);
+        rank_table[u->rank] = u;
+        if (u->rank > max_rank) max_rank = u->rank;
+    }
+
+    void add_root(Node* node) {
+        node->is_root = true;
+        if (MultiRoot) {
+            node->next = root_list;
+            root_list = node;
+            if (!root || node->key < root->key)
+                root = node;
+        } else {
+            node->next = nullptr;
+            root = root ? link(node, root) : node;
+        }
+    }
+
+    // Iterative teardown; nodes with two parents are freed exactly once by
+    // following the same extra-parent rule as extract-min
+    void delete_all() {
+        Node* h = MultiRoot ? root_list : root;
+        while (h) {
+            Node* w = h->child;
+            Node* x = h;
+            h = h->next;
+            while (w) {
+                Node* u = w;
+                w = w->next;
+                if (!u->ep) {
+                    u->next = h;
+                    h = u;
+                } else {
+                    if (u->ep == x)
+                        w = nullptr;
+                    else
+                        u->next = nullptr;
+                    u->ep = nullptr;
+                }
+            }
+            delete x->item;
+            delete x;
+        }
+    }
+};
+
+using HollowHeapSingleRoot = HollowHeap<false>;
+using HollowHeapMultiRoot  = HollowHeap<true>;
@@ -0,0 +1,132 @@
+#pragma once
+// Log-bucketed (HDR-style) latency histograms for per-operation heap timing
+// Values below 32 ns get a bucket each; above that every power-of-two range
+// is split into 32 equal sub-buckets, so any reported percentile is within
+// ~3% of the true value whether an operation took 40 ns or 40 ms. The table
+// covers up to 2^41 ns (~37 min) in 1184 buckets and is allocated on first use.
+// The heaps call record() next to their existing op timing. One in
+// sample_every() calls goes into the buckets (default 1: the heaps already pay
+// for two clock reads per operation, and the bucket update is a bit scan and
+// an increment); max is tracked on every call, so a rare expensive
+// consolidate or cascading cut is never sampled away.
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+struct LatencySummary {
+    std::uint64_t samples = 0; // operations in the buckets
+    double p50 = 0, p99 = 0, p999 = 0, max = 0; // ns
+};
+
+namespace latency {
+
+// Global sampling period for all histograms; set before a run
+inline std::atomic<unsigned>& sample_every() {
+    static std::atomic<unsigned> every{1};
+    return every;
+}
+
+} // namespace latency
+
+class LatencyHistogram {
+public:
+    static constexpr int sub_bits = 5;
+    static constexpr std::uint64_t sub_count = std::uint64_t(1) << sub_bits;
+    static constexpr int max_exponent = 40; // values clamp below 2^(max_exponent + 1)
+    static constexpr std::size_t bucket_count = (max_exponent - sub_bits + 2) * sub_count;
+
+    template<typename TimePoint>
+    void record(TimePoint start, TimePoint end) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        record_ns(ns > 0 ? static_cast<std::uint64_t>(ns) : 0);
+    }
+
+    void record_ns(std::uint64_t ns) {
+        max_ns = std::max(max_ns, ns);
+        if (++tick < latency::sample_every().load(std::memory_order_relaxed)) return;
+        tick = 0;
+        if (counts.empty()) counts.assign(bucket_count, 0);
+        counts[bucket_of(ns)]++;
+        total++;
+    }
+
+    std::uint64_t samples() const { return total; }
+    std::uint64_t max() const { return max_ns; }
+
+    // Value at quantile q in [0, 1] (bucket midpoint, capped at the exact max)
+    double percentile(double q) const {
+        if (total == 0) return 0.0;
+        auto rank = static_cast<std::uint64_t>(std::ceil(std::min(std::max(q, 0.0), 1.0) * total));
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucket_mid(i), static_cast<double>(max_ns));
+        }
+        return static_cast<double>(max_ns);
+    }
+
+    LatencySummary summary() const {
+        LatencySummary s;
+        s.samples = total;
+        s.p50 = percentile(0.50);
+        s.p99 = percentile(0.99);
+        s.p999 = percentile(0.999);
+        s.max = static_cast<double>(max_ns);
+        return s;
+    }
+
+    void merge(const LatencyHistogram& o) {
+        if (o.total) {
+            if (counts.empty()) counts.assign(bucket_count, 0);
+            for (std::size_t i = 0; i < bucket_count; i++) counts[i] += o.counts[i];
+            total += o.total;
+        }
+        max_ns = std::max(max_ns, o.max_ns);
+    }
+
+    void clear() {
+        counts.clear();
+        total = 0;
+        max_ns = 0;
+        tick = 0;
+    }
+
+    static std::size_t bucket_of(std::uint64_t v) {
+        if (v < sub_count) return static_cast<std::size_t>(v);
+        int e = highest_bit(v);
+        if (e > max_exponent) return bucket_count - 1;
+        int shift = e - sub_bits;
+        return static_cast<std::size_t>((shift + 1) * sub_count + ((v >> shift) - sub_count));
+    }
+
+    // Index of the highest set bit (v > 0); the builtin is GCC / Clang only
+    static int highest_bit(std::uint64_t v) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(v);
+#else
+        int e = 0;
+        while (v >>= 1) e++;
+        return e;
+#endif
+    }
+
+    static double bucket_mid(std::size_t i) {
+        std::size_t block = i / sub_count;
+        if (block == 0) return static_cast<double>(i);
+        int shift = static_cast<int>(block) - 1;
+        double lo = static_cast<double>((sub_count + i % sub_count) << shift);
+        return lo + static_cast<double>((std::uint64_t(1) << shift) - 1) / 2;
+    }
+
+private:
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total = 0;
+    std::uint64_t max_ns = 0;
+    unsigned tick = 0;
+};
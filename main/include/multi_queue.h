@@ -0,0 +1,128 @@
+#pragma once
+// MultiQueue: relaxed concurrent priority queue (Rihani, Sanders, Dementiev)
+// c * p ordinary sequential heaps, each behind its own try-lock. A push goes
+// to a random unlocked heap; a pop samples two random heaps, reads their
+// cached minimum keys without locking and takes from the smaller one. The
+// element returned is not the global minimum but is close to it with high
+// probability, and threads almost never wait for each other.
+// The sequential heap only needs insert / extract_min / find_min / empty
+// (BinaryHeap, DaryHeap, SequenceHeap, ...); handles are ignored, so use the
+// lazy-deletion pattern (push duplicates, skip stale pops).
+
+#include "dary_heap.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <utility>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+template<typename Heap = DaryHeap>
+class MultiQueue {
+public:
+    using Key = typename Heap::Key;
+    using Vertex = typename Heap::Vertex;
+
+    // Per-thread random source for lane selection (one per worker, not shared)
+    using Rng = std::minstd_rand;
+
+    // threads * lanes_per_thread sequential heaps (c = lanes_per_thread)
+    MultiQueue(int threads, int lanes_per_thread = 2)
+        : num_lanes(static_cast<std::size_t>(std::max(1, threads * lanes_per_thread))),
+          lanes(new Lane[num_lanes]) {}
+
+    MultiQueue(const MultiQueue&) = delete;
+    MultiQueue& operator=(const MultiQueue&) = delete;
+
+    std::size_t lane_count() const { return num_lanes; }
+
+    void push(Vertex vertex, Key key, Rng& rng) {
+        while (true) {
+            Lane& lane = lanes[pick(rng)];
+            if (!lane.try_lock()) continue;
+            lane.heap.insert(vertex, key);
+            lane.publish_top();
+            lane.unlock();
+            return;
+        }
+    }
+
+    // Pop an element close to the minimum. Returns false once every lane was
+    // seen empty (or busy); with concurrent pushers this can be transient, so
+    // callers decide termination themselves (e.g. with an in-flight counter).
+    // Keys equal to the key type's infinity / max() read as an empty lane.
+    bool try_pop(std::pair<Vertex, Key>& out, Rng& rng) {
+        for (std::size_t attempt = 0; attempt < 2 * num_lanes; attempt++) {
+            std::size_t a = pick(rng), b = pick(rng);
+            Key ka = lanes[a].top.load(std::memory_order_relaxed);
+            Key kb = lanes[b].top.load(std::memory_order_relaxed);
+            Lane& lane = lanes[kb < ka ? b : a];
+            if (!(std::min(ka, kb) < empty_key())) continue;
+            if (!lane.try_lock()) continue;
+            if (lane.heap.empty()) {
+                lane.unlock();
+                continue;
+            }
+            out = lane.heap.extract_min();
+            lane.publish_top();
+            lane.unlock();
+            return true;
+        }
+
+        // Sampling kept missing: fall back to a sweep over all lanes
+        for (std::size_t i = 0; i < num_lanes; i++) {
+            Lane& lane = lanes[i];
+            if (!(lane.top.load(std::memory_order_relaxed) < empty_key())) continue;
+            if (!lane.try_lock()) return false; // busy, not empty: caller polls again
+            if (!lane.heap.empty()) {
+                out = lane.heap.extract_min();
+                lane.publish_top();
+                lane.unlock();
+                return true;
+            }
+            lane.unlock();
+        }
+        return false;
+    }
+
+    // Visit every lane's heap, e.g. to add up metrics (only while no thread uses the queue)
+    template<typename Fn>
+    void for_each_heap(Fn&& fn) const {
+        for (std::size_t i = 0; i < num_lanes; i++) fn(lanes[i].heap);
+    }
+
+    static const char* name() { return "MultiQueue"; }
+
+private:
+    // Each lane starts on its own cache line, so lock and top traffic of
+    // neighbouring lanes doesn't false-share
+    struct alignas(64) Lane {
+        std::atomic<bool> locked{false};
+        std::atomic<Key> top{empty_key()}; // cached minimum, read without the lock
+        Heap heap;
+
+        bool try_lock() {
+            return !locked.load(std::memory_order_relaxed) &&
+                   !locked.exchange(true, std::memory_order_acquire);
+        }
+        void unlock() { locked.store(false, std::memory_order_release); }
+
+        void publish_top() {
+            top.store(heap.empty() ? empty_key() : heap.find_min().second,
+                      std::memory_order_relaxed);
+        }
+    };
+
+    std::size_t num_lanes;
+    std::unique_ptr<Lane[]> lanes;
+
+    static Key empty_key() {
+        return std::numeric_limits<Key>::has_infinity ? std::numeric_limits<Key>::infinity()
+                                                      : std::numeric_limits<Key>::max();
+    }
+
+    std::size_t pick(Rng& rng) const { return static_cast<std::size_t>(rng()) % num_lanes; }
+};
@@ -0,0 +1,230 @@
+#pragma once
+// Page-size and NUMA placement control for large arrays
+// A MemoryPolicy says how a block's pages are backed:
+//   PageMode::Small       - 4 KB pages (transparent huge pages explicitly off)
+//   PageMode::Transparent - 2 MB-aligned mapping advised MADV_HUGEPAGE, so the
+//                           kernel backs it with transparent huge pages
+//   PageMode::Explicit    - MAP_HUGETLB from the hugetlbfs pool; falls back to
+//                           Transparent when the pool is empty (counted)
+// and where they live on a multi-socket machine:
+//   NumaPlacement::FirstTouch - the node of the thread that first writes a page
+//   NumaPlacement::Interleave - round-robin over all nodes (mbind MPOL_INTERLEAVE)
+//   NumaPlacement::Bind       - all pages on `node` (mbind MPOL_BIND)
+// Blocks under min_mapped_bytes, and the default policy (Small + FirstTouch),
+// go through operator new, so small vectors cost nothing extra. Larger blocks
+// are mmap'd and placed before their first touch. PageAllocator<T> applies a
+// policy to any std container; PageVector<T> is the vector shorthand.
+// Non-Linux builds accept every policy and use operator new.
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+enum class PageMode { Small, Transparent, Explicit };
+enum class NumaPlacement { FirstTouch, Interleave, Bind };
+
+struct MemoryPolicy {
+    PageMode pages = PageMode::Small;
+    NumaPlacement numa = NumaPlacement::FirstTouch;
+    int node = 0; // target node for NumaPlacement::Bind
+
+    bool is_default() const { return pages == PageMode::Small && numa == NumaPlacement::FirstTouch; }
+
+    std::string name() const {
+        std::string s = pages == PageMode::Small ? "4K" : pages == PageMode::Transparent ? "THP" : "HugeTLB";
+        if (numa == NumaPlacement::Interleave) s += "+interleave";
+        if (numa == NumaPlacement::Bind) s += "+bind" + std::to_string(node);
+        return s;
+    }
+
+    bool operator==(const MemoryPolicy& o) const {
+        return pages == o.pages && numa == o.numa && node == o.node;
+    }
+    bool operator!=(const MemoryPolicy& o) const { return !(*this == o); }
+};
+
+namespace page_memory {
+
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;  // x86-64 / arm64 default
+constexpr std::size_t min_mapped_bytes = std::size_t(1) << 20;
+
+struct Counters {
+    std::atomic<std::uint64_t> mapped_blocks{0};
+    std::atomic<std::uint64_t> explicit_fallbacks{0}; // MAP_HUGETLB failed, used THP
+    std::atomic<std::uint64_t> placement_failures{0}; // mbind rejected
+};
+
+inline Counters& counters() {
+    static Counters c;
+    return c;
+}
+
+// Policy picked up by default-constructed PageAllocators
+inline MemoryPolicy& default_policy() {
+    static MemoryPolicy policy;
+    return policy;
+}
+
+// NUMA nodes with memory, from sysfs (1 where unknown)
+inline int numa_node_count() {
+    int n = 0;
+    while (std::ifstream("/sys/devices/system/node/node" + std::to_string(n) + "/meminfo")) n++;
+    return n > 0 ? n : 1;
+}
+
+inline bool is_mapped(std::size_t bytes, const MemoryPolicy& policy) {
+#if defined(__linux__)
+    return bytes >= min_mapped_bytes && !policy.is_default();
+#else
+    (void)bytes;
+    (void)policy;
+    return false;
+#endif
+}
+
+inline std::size_t mapped_length(std::size_t bytes) {
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+#if defined(__linux__)
+// 2 MB-aligned anonymous mapping of len bytes (len a multiple of 2 MB)
+inline void* map_aligned(std::size_t len) {
+    void* raw = mmap(nullptr, len + huge_page_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+    auto addr = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (addr + huge_page_size - 1) / huge_page_size * huge_page_size;
+    if (aligned > addr) munmap(raw, aligned - addr);
+    std::size_t tail = addr + len + huge_page_size - (aligned + len);
+    if (tail) munmap(reinterpret_cast<void*>(aligned + len), tail);
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void place(void* ptr, std::size_t len, const MemoryPolicy& policy) {
+    if (policy.numa == NumaPlacement::FirstTouch) return;
+    unsigned long mask = 0;
+    int nodes = numa_node_count();
+    int mode = MPOL_BIND;
+    if (policy.numa == NumaPlacement::Interleave) {
+        mode = MPOL_INTERLEAVE;
+        for (int n = 0; n < nodes && n < 64; n++) mask |= 1UL << n;
+    } else {
+        mask = 1UL << (policy.node % 64);
+    }
+    if (syscall(SYS_mbind, ptr, len, mode, &mask, 64UL, 0UL) != 0)
+        counters().placement_failures++;
+}
+#endif
+
+inline void* allocate(std::size_t bytes, const MemoryPolicy& policy) {
+#if defined(__linux__)
+    if (is_mapped(bytes, policy)) {
+        std::size_t len = mapped_length(bytes);
+        void* ptr = nullptr;
+        if (policy.pages == PageMode::Explicit) {
+            ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr == MAP_FAILED) {
+                ptr = nullptr;
+                counters().explicit_fallbacks++;
+            }
+        }
+        if (!ptr) {
+            ptr = map_aligned(len);
+            if (!ptr) throw std::bad_alloc();
+            madvise(ptr, len, policy.pages == PageMode::Small ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+        }
+        place(ptr, len, policy);
+        counters().mapped_blocks++;
+        return ptr;
+    }
+#endif
+    return ::operator new(bytes);
+}
+
+// bytes and policy must be the ones passed to allocate
+inline void release(void* ptr, std::size_t bytes, const MemoryPolicy& policy) {
+#if defined(__linux__)
+    if (is_mapped(bytes, policy)) {
+        munmap(ptr, mapped_length(bytes));
+        return;
+    }
+#endif
+    ::operator delete(ptr);
+}
+
+// Huge-page bytes (AnonHugePages + Private_Hugetlb) of the mappings that
+// overlap [ptr, ptr + bytes), from /proc/self/smaps; -1 where unavailable.
+// Adjacent mappings with identical flags may be merged by the kernel and
+// are then counted whole.
+inline long long huge_page_bytes(const void* ptr, std::size_t bytes) {
+    std::ifstream smaps("/proc/self/smaps");
+    if (!smaps) return -1;
+    auto lo = reinterpret_cast<std::uintptr_t>(ptr);
+    auto hi = lo + bytes;
+    long long total = 0;
+    bool inside = false;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        std::size_t dash = line.find('-');
+        std::size_t space = line.find(' ');
+        if (dash != std::string::npos && space != std::string::npos && dash < space &&
+            line.find(':') > space) {
+            std::uintptr_t start = std::stoull(line.substr(0, dash), nullptr, 16);
+            std::uintptr_t end = std::stoull(line.substr(dash + 1, space - dash - 1), nullptr, 16);
+            inside = start < hi && lo < end;
+            continue;
+        }
+        if (!inside) continue;
+        std::istringstream fields(line);
+        std::string key;
+        long long kb = 0;
+        if (fields >> key >> kb && (key == "AnonHugePages:" || key == "Private_Hugetlb:"))
+            total += kb * 1024;
+    }
+    return total;
+}
+
+} // namespace page_memory
+
+// Allocator applying a MemoryPolicy (page_memory::default_policy() unless given)
+template<typename T>
+class PageAllocator {
+public:
+    using value_type = T;
+
+    PageAllocator() : policy(page_memory::default_policy()) {}
+    explicit PageAllocator(MemoryPolicy p) : policy(p) {}
+    template<typename U>
+    PageAllocator(const PageAllocator<U>& other) : policy(other.memory_policy()) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(page_memory::allocate(n * sizeof(T), policy));
+    }
+    void deallocate(T* p, std::size_t n) { page_memory::release(p, n * sizeof(T), policy); }
+
+    const MemoryPolicy& memory_policy() const { return policy; }
+
+    template<typename U>
+    bool operator==(const PageAllocator<U>& o) const { return policy == o.memory_policy(); }
+    template<typename U>
+    bool operator!=(const PageAllocator<U>& o) const { return !(*this == o); }
+
+private:
+    MemoryPolicy policy;
+};
+
+template<typename T>
+using PageVector = std::vector<T, PageAllocator<T>>;
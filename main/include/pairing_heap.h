@@ -3,20 +3,30 @@
 // Adapted from the implementation in main/pairing/pairingheap.cpp
 // Supports: insert (returns handle), extract-min, decrease-key, find-min
 // Includes built-in metrics tracking for benchmarking
+// Templated on key and vertex-id types; PairingHeap is the double/int default
 
+#include "trace.h"
+#include "latency_histogram.h"
+#include "heap_shape.h"
 #include <utility>
+#include <vector>
 #include <chrono>
+#include <cstdint>
 
-class PairingHeap {
+template<typename KeyT = double, typename VertexT = int>
+class BasicPairingHeap {
 public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
     struct Node {
-        double key;
-        int vertex;
+        Key key;
+        Vertex vertex;
         Node* left_child;
         Node* next_sibling;
         Node* parent;
 
-        Node(double k, int v)
+        Node(Key k, Vertex v)
             : key(k), vertex(v),
               left_child(nullptr), next_sibling(nullptr), parent(nullptr) {}
 
@@ -39,13 +49,17 @@ public:
     int decrease_key_count = 0;
     double extract_min_time_ns = 0;
     double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+    using ShapeStats = PairingShapeStats;
+    ShapeStats* shape_stats = nullptr; // optional shape telemetry (heap_shape.h)
 
-    PairingHeap() : root(nullptr), n(0) {}
+    BasicPairingHeap() : root(nullptr), n(0) {}
 
-    ~PairingHeap() { delete_all(root); }
+    ~BasicPairingHeap() { clear(); }
 
     // Insert a vertex with given priority; returns a handle for decrease-key
-    Handle* insert(int vertex, double priority) {
+    Handle* insert(Vertex vertex, Key priority) {
         insert_count++;
         Node* node = new Node(priority, vertex);
         root = merge(root, node);
@@ -53,13 +67,40 @@ public:
         return node;
     }
 
+    // Bulk-load (vertex, priority) pairs by melding trees pairwise, round after
+    // round, in O(n) total; returns the handles in the same order as items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        for (const auto& [vertex, priority] : items)
+            handles.push_back(new Node(priority, vertex));
+
+        std::vector<Node*> trees(handles.begin(), handles.end());
+        while (trees.size() > 1) {
+            size_t out = 0;
+            for (size_t i = 0; i + 1 < trees.size(); i += 2)
+                trees[out++] = merge(trees[i], trees[i + 1]);
+            if (trees.size() % 2) trees[out++] = trees.back();
+            trees.resize(out);
+        }
+        if (!trees.empty()) root = merge(root, trees[0]);
+        n += static_cast<int>(items.size());
+        return handles;
+    }
+
     // Remove and return the minimum element as (vertex, priority)
-    std::pair<int, double> extract_min() {
+    std::pair<Vertex, Key> extract_min() {
+        if (shape_stats) { // untimed
+            std::uint64_t children = 0;
+            for (Node* c = root->left_child; c; c = c->next_sibling) children++;
+            shape_stats->children.add(children);
+        }
         auto start = std::chrono::high_resolution_clock::now();
         extract_min_count++;
 
-        int vertex = root->vertex;
-        double key = root->key;
+        Vertex vertex = root->vertex;
+        Key key = root->key;
 
         Node* old_root = root;
         root = two_pass_merge(root->left_child);
@@ -70,12 +111,19 @@ public:
         auto end = std::chrono::high_resolution_clock::now();
         extract_min_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
 
         return {vertex, key};
     }
 
     // Decrease the priority of a previously inserted node
-    void decrease_key(Handle* node, double new_key) {
+    void decrease_key(Handle* node, Key new_key) {
+        if (shape_stats) { // untimed
+            std::uint64_t depth = 0;
+            for (Node* p = node->parent; p; p = p->parent) depth++;
+            shape_stats->depth.add(depth);
+        }
         auto start = std::chrono::high_resolution_clock::now();
         decrease_key_count++;
 
@@ -83,6 +131,8 @@ public:
             auto end = std::chrono::high_resolution_clock::now();
             decrease_key_time_ns += static_cast<double>(
                 std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
             return;
         }
 
@@ -93,18 +143,25 @@ public:
             auto end = std::chrono::high_resolution_clock::now();
             decrease_key_time_ns += static_cast<double>(
                 std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
             return;
         }
 
         // Detach node from its parent
         if (node->parent->left_child == node) {
             node->parent->left_child = node->next_sibling;
+            if (shape_stats) shape_stats->leftmost_detaches++;
         } else {
             Node* sibling = node->parent->left_child;
-            while (sibling && sibling->next_sibling != node)
+            std::uint64_t scanned = 1;
+            while (sibling && sibling->next_sibling != node) {
                 sibling = sibling->next_sibling;
+                scanned++;
+            }
             if (sibling)
                 sibling->next_sibling = node->next_sibling;
+            if (shape_stats) shape_stats->sibling_scan.add(scanned);
         }
 
         node->next_sibling = nullptr;
@@ -116,21 +173,32 @@ public:
         auto end = std::chrono::high_resolution_clock::now();
         decrease_key_time_ns += static_cast<double>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
     }
 
     bool empty() const { return root == nullptr; }
     int size() const { return n; }
 
-    std::pair<int, double> find_min() const {
+    std::pair<Vertex, Key> find_min() const {
         return {root->vertex, root->key};
     }
 
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        delete_all(root);
+        root = nullptr;
+        n = 0;
+    }
+
     void reset_metrics() {
         insert_count = 0;
         extract_min_count = 0;
         decrease_key_count = 0;
         extract_min_time_ns = 0;
         decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
     }
 
     static const char* name() { return "PairingHeap"; }
@@ -152,26 +220,53 @@ private:
     }
 
     // Two-pass merge (used in extract-min): pair up siblings left-to-right,
-    // then merge resulting trees right-to-left
+    // then merge resulting trees right-to-left. Iterative, since a root can
+    // have as many children as the heap has entries (e.g. after n inserts).
     static Node* two_pass_merge(Node* node) {
         if (!node || !node->next_sibling) return node;
 
-        Node* a = node;
-        Node* b = node->next_sibling;
-        Node* rest = b->next_sibling;
-
-        a->next_sibling = nullptr;
-        a->parent = nullptr;
-        b->next_sibling = nullptr;
-        b->parent = nullptr;
+        // First pass; the merged pairs are chained through next_sibling in
+        // reverse order, so the second pass walks them right-to-left
+        Node* pairs = nullptr;
+        while (node) {
+            Node* a = node;
+            Node* b = node->next_sibling;
+            node = b ? b->next_sibling : nullptr;
+
+            a->next_sibling = nullptr;
+            a->parent = nullptr;
+            if (b) {
+                b->next_sibling = nullptr;
+                b->parent = nullptr;
+                a = merge(a, b);
+            }
+            a->next_sibling = pairs;
+            pairs = a;
+        }
 
-        return merge(merge(a, b), two_pass_merge(rest));
+        Node* result = pairs;
+        pairs = pairs->next_sibling;
+        result->next_sibling = nullptr;
+        while (pairs) {
+            Node* next = pairs->next_sibling;
+            pairs->next_sibling = nullptr;
+            result = merge(pairs, result);
+            pairs = next;
+        }
+        return result;
     }
 
     void delete_all(Node* node) {
-        if (!node) return;
-        delete_all(node->left_child);
-        delete_all(node->next_sibling);
-        delete node;
+        std::vector<Node*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node* x = stack.back();
+            stack.pop_back();
+            if (x->left_child) stack.push_back(x->left_child);
+            if (x->next_sibling) stack.push_back(x->next_sibling);
+            delete x;
+        }
     }
 };
+
+using PairingHeap = BasicPairingHeap<>;
@@ -0,0 +1,156 @@
+#pragma once
+// Parallel label-correcting SSSP on a MultiQueue
+// Worker threads pop (vertex, distance) pairs from a shared MultiQueue, skip
+// stale entries, and relax the vertex's edges with an atomic compare-and-swap
+// "min" on dist; every successful improvement pushes a new entry. Because the
+// queue only approximately respects priority order, a vertex can be scanned
+// with a distance that is later improved, and that scan's relaxations are
+// wasted work. The stats measure exactly this: relaxations beyond the
+// sequential Dijkstra count of one scan per reachable vertex.
+// The search ends when no entry is queued or being processed (in-flight
+// counter reaches zero). Parents are derived afterwards from the final
+// distances, since dist and parent can't be updated together atomically.
+
+#include "graph.h"
+#include "algorithms.h"
+#include "multi_queue.h"
+#include "trace.h"
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+struct ParallelSearchStats {
+    int threads = 0;
+    std::size_t lanes = 0;
+    std::uint64_t pushes = 0;
+    std::uint64_t pops = 0;
+    std::uint64_t stale_pops = 0;   // entries whose distance was already improved
+    std::uint64_t relaxations = 0;  // edges examined by non-stale scans
+    std::uint64_t useful_relaxations = 0; // one scan per reachable vertex (sequential Dijkstra)
+
+    std::uint64_t wasted_relaxations() const { return relaxations - useful_relaxations; }
+    double wasted_fraction() const {
+        return relaxations ? static_cast<double>(wasted_relaxations()) / relaxations : 0.0;
+    }
+};
+
+template<typename Heap = DaryHeap, typename G>
+BasicDijkstraResult<typename G::Weight, typename G::Vertex>
+parallel_sssp(const G& g, typename G::Vertex source, int threads,
+              ParallelSearchStats* stats = nullptr, int lanes_per_thread = 2) {
+    using Key = typename G::Weight;
+    using Vertex = typename G::Vertex;
+    static_assert(std::is_same<Key, typename Heap::Key>::value &&
+                  std::is_same<Vertex, typename Heap::Vertex>::value,
+                  "heap key / vertex types must match the graph's");
+    const std::size_t n = static_cast<std::size_t>(g.size());
+    if (threads < 1) threads = 1;
+
+    std::vector<std::atomic<Key>> dist(n);
+    for (auto& d : dist) d.store(infinite_weight<Key>(), std::memory_order_relaxed);
+
+    MultiQueue<Heap> queue(threads, lanes_per_thread);
+    std::atomic<std::int64_t> in_flight{1};
+    dist[source].store(Key(0), std::memory_order_relaxed);
+    {
+        typename MultiQueue<Heap>::Rng rng(12345);
+        queue.push(source, Key(0), rng);
+    }
+
+    struct alignas(64) Counters {
+        std::uint64_t pushes = 0, pops = 0, stale_pops = 0, relaxations = 0;
+    };
+    std::vector<Counters> counters(static_cast<std::size_t>(threads));
+
+    // Each traced call is numbered and named after its heap and thread count
+    // ("sssp #3 DaryHeap x4"), so the new worker tracks of several runs in
+    // one trace can be told apart
+    std::string run_label;
+    const char* zone_name = "parallel_sssp worker";
+    if (trace::enabled()) {
+        static std::atomic<unsigned> runs{0};
+        run_label = "sssp #" + std::to_string(++runs) + " " + Heap::name() + " x" + std::to_string(threads);
+        zone_name = trace::intern(run_label);
+    }
+
+    auto worker = [&](int id) {
+        if (id > 0 && !run_label.empty()) trace::set_thread_name(run_label + " worker " + std::to_string(id));
+        trace::Zone zone(zone_name, "search");
+        typename MultiQueue<Heap>::Rng rng(static_cast<unsigned>(id) * 7919u + 1u);
+        Counters& c = counters[static_cast<std::size_t>(id)];
+        std::pair<Vertex, Key> item;
+        while (true) {
+            if (!queue.try_pop(item, rng)) {
+                if (in_flight.load(std::memory_order_acquire) == 0) break;
+                std::this_thread::yield();
+                continue;
+            }
+            c.pops++;
+            auto [u, d] = item;
+            if (d > dist[u].load(std::memory_order_relaxed)) {
+                c.stale_pops++;
+                in_flight.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            for (const auto& e : g.adj[u]) {
+                c.relaxations++;
+                Key cand = d + e.weight;
+                Key cur = dist[e.to].load(std::memory_order_relaxed);
+                while (cand < cur) {
+                    if (dist[e.to].compare_exchange_weak(cur, cand, std::memory_order_relaxed)) {
+                        // Count the new entry before this one is retired, so
+                        // in_flight can't touch zero while work remains
+                        in_flight.fetch_add(1, std::memory_order_relaxed);
+                        queue.push(e.to, cand, rng);
+                        c.pushes++;
+                        break;
+                    }
+                }
+            }
+            in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    BasicDijkstraResult<Key, Vertex> result;
+    result.dist.resize(n);
+    for (std::size_t v = 0; v < n; v++) result.dist[v] = dist[v].load(std::memory_order_relaxed);
+
+    // With positive weights any tight edge gives a valid shortest-path tree parent
+    result.parent.assign(n, no_vertex<Vertex>());
+    std::uint64_t useful = 0;
+    for (std::size_t u = 0; u < n; u++) {
+        if (result.dist[u] == infinite_weight<Key>()) continue;
+        useful += g.adj[u].size();
+        for (const auto& e : g.adj[u]) {
+            if (static_cast<Vertex>(e.to) != source &&
+                result.parent[e.to] == no_vertex<Vertex>() &&
+                result.dist[u] + e.weight == result.dist[e.to])
+                result.parent[e.to] = static_cast<Vertex>(u);
+        }
+    }
+
+    if (stats) {
+        *stats = ParallelSearchStats();
+        stats->threads = threads;
+        stats->lanes = queue.lane_count();
+        stats->pushes = 1;
+        for (const auto& c : counters) {
+            stats->pushes += c.pushes;
+            stats->pops += c.pops;
+            stats->stale_pops += c.stale_pops;
+            stats->relaxations += c.relaxations;
+        }
+        stats->useful_relaxations = useful;
+    }
+    return result;
+}
@@ -0,0 +1,89 @@
+#pragma once
+// Hardware event counters for benchmark sections
+// Uses Linux perf_event_open (user space only):
+//   CacheMissCounter - last-level cache misses
+//   DtlbMissCounter  - data-TLB load misses (page walks; see page_memory.h)
+// Where the counter can't be opened (non-Linux, no PMU in a VM, or
+// perf_event_paranoid too strict) available() is false and the benchmark
+// prints "n/a" instead of a count.
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+enum class PerfEvent { CacheMisses, DtlbLoadMisses };
+
+class PerfEventCounter {
+public:
+    explicit PerfEventCounter(PerfEvent event) {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        if (event == PerfEvent::DtlbLoadMisses) {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        } else {
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        }
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    ~PerfEventCounter() {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfEventCounter(const PerfEventCounter&) = delete;
+    PerfEventCounter& operator=(const PerfEventCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Events since start(); 0 when unavailable
+    std::uint64_t stop() {
+        std::uint64_t count = 0;
+#if defined(__linux__)
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+            count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+class CacheMissCounter : public PerfEventCounter {
+public:
+    CacheMissCounter() : PerfEventCounter(PerfEvent::CacheMisses) {}
+};
+
+class DtlbMissCounter : public PerfEventCounter {
+public:
+    DtlbMissCounter() : PerfEventCounter(PerfEvent::DtlbLoadMisses) {}
+};
@@ -0,0 +1,355 @@
+#pragma once
+// Pairing Heap variant with O(1) detach and selectable merge strategies
+// Each node keeps a prev pointer (left sibling, or parent for the leftmost
+// child) so decrease-key unlinks a subtree without scanning the sibling list.
+// All merge passes are iterative, so a root with millions of children cannot
+// exhaust the call stack.
+// Supports: insert (returns handle), extract-min, decrease-key, find-min
+// Includes built-in metrics tracking for benchmarking
+// Key and vertex-id types are trailing template parameters (default double/int)
+
+#include "trace.h"
+#include "latency_histogram.h"
+#include <utility>
+#include <vector>
+#include <chrono>
+
+namespace pairing_merge {
+
+// Shared node layout for all merge policies
+template<typename Key, typename Vertex>
+struct Node {
+    Key key;
+    Vertex vertex;
+    Node* child;
+    Node* next; // right sibling
+    Node* prev; // left sibling, or parent if leftmost child; nullptr for roots
+
+    Node(Key k, Vertex v)
+        : key(k), vertex(v), child(nullptr), next(nullptr), prev(nullptr) {}
+};
+
+// Link two detached roots; the loser becomes the leftmost child of the winner
+template<typename Node>
+inline Node* link(Node* a, Node* b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (b->key < a->key) std::swap(a, b);
+    b->next = a->child;
+    if (a->child) a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+
+// Standard two-pass: pair siblings left-to-right, then merge right-to-left
+struct TwoPass {
+    static constexpr bool auxiliary = false;
+    static const char* name() { return "Pairing2Pass"; }
+
+    template<typename Node>
+    static Node* combine(Node* first) {
+        if (!first) return nullptr;
+
+        // First pass: pairs are pushed onto a stack (linked through next),
+        // so the rightmost pair ends up on top for the second pass
+        Node* pairs = nullptr;
+        while (first) {
+            Node* a = first;
+            Node* b = a->next;
+            if (!b) {
+                a->next = pairs;
+                pairs = a;
+                break;
+            }
+            first = b->next;
+            a->next = nullptr;
+            b->next = nullptr;
+            Node* t = link(a, b);
+            t->next = pairs;
+            pairs = t;
+        }
+
+        // Second pass: accumulate from the rightmost pair back to the leftmost
+        Node* result = pairs;
+        pairs = pairs->next;
+        result->next = nullptr;
+        while (pairs) {
+            Node* rest = pairs->next;
+            pairs->next = nullptr;
+            result = link(pairs, result);
+            pairs = rest;
+        }
+        result->prev = nullptr;
+        return result;
+    }
+};
+
+// Multipass: repeatedly link the first two trees and append the result to
+// the back of the queue until a single tree remains
+struct Multipass {
+    static constexpr bool auxiliary = false;
+    static const char* name() { return "PairingMulti"; }
+
+    template<typename Node>
+    static Node* combine(Node* first) {
+        if (!first) return nullptr;
+
+        Node* head = first;
+        Node* tail = first;
+        while (tail->next) tail = tail->next;
+
+        while (head->next) {
+            Node* a = head;
+            Node* b = a->next;
+            head = b->next;
+            a->next = nullptr;
+            b->next = nullptr;
+            Node* t = link(a, b);
+            if (!head) {
+                head = t;
+            } else {
+                tail->next = t;
+            }
+            tail = t;
+        }
+        head->prev = nullptr;
+        return head;
+    }
+};
+
+// Back-to-front: walk to the rightmost sibling, then link each tree into
+// the accumulated result moving left (uses prev pointers)
+struct BackToFront {
+    static constexpr bool auxiliary = false;
+    static const char* name() { return "PairingB2F"; }
+
+    template<typename Node>
+    static Node* combine(Node* first) {
+        if (!first) return nullptr;
+
+        Node* last = first;
+        while (last->next) last = last->next;
+
+        // Read each left neighbour before linking, since link() rewrites prev
+        Node* result = last;
+        Node* curr = (last == first) ? nullptr : last->prev;
+        while (curr) {
+            Node* left = (curr == first) ? nullptr : curr->prev;
+            curr->next = nullptr;
+            result = link(curr, result);
+            curr = left;
+        }
+        result->prev = nullptr;
+        return result;
+    }
+};
+
+// Auxiliary two-pass (Stasko & Vitter): inserted and decreased nodes are kept
+// in a side list and only combined (multipass) at the next extract-min;
+// the children of the removed root are combined with two-pass
+struct AuxTwoPass {
+    static constexpr bool auxiliary = true;
+    static const char* name() { return "PairingAux2Pass"; }
+
+    template<typename Node>
+    static Node* combine(Node* first) { return TwoPass::combine(first); }
+    template<typename Node>
+    static Node* combine_aux(Node* first) { return Multipass::combine(first); }
+};
+
+} // namespace pairing_merge
+
+template<typename MergePolicy, typename KeyT = double, typename VertexT = int>
+class PolicyPairingHeap {
+public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+    using Node = pairing_merge::Node<Key, Vertex>;
+    using Handle = Node;
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0;
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    PolicyPairingHeap() : root(nullptr), aux(nullptr), aux_min(nullptr), n(0) {}
+
+    ~PolicyPairingHeap() { clear(); }
+
+    PolicyPairingHeap(const PolicyPairingHeap&) = delete;
+    PolicyPairingHeap& operator=(const PolicyPairingHeap&) = delete;
+
+    // Insert a vertex with given priority; returns a handle for decrease-key
+    Handle* insert(Vertex vertex, Key priority) {
+        insert_count++;
+        Node* node = new Node(priority, vertex);
+        add_root(node);
+        n++;
+        return node;
+    }
+
+    // Bulk-load (vertex, priority) pairs by melding trees pairwise, round after
+    // round, in O(n) total; returns the handles in the same order as items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        for (const auto& [vertex, priority] : items)
+            handles.push_back(new Node(priority, vertex));
+
+        std::vector<Node*> trees(handles.begin(), handles.end());
+        while (trees.size() > 1) {
+            size_t out = 0;
+            for (size_t i = 0; i + 1 < trees.size(); i += 2)
+                trees[out++] = pairing_merge::link(trees[i], trees[i + 1]);
+            if (trees.size() % 2) trees[out++] = trees.back();
+            trees.resize(out);
+        }
+        if (!trees.empty()) root = pairing_merge::link(root, trees[0]);
+        n += static_cast<int>(items.size());
+        return handles;
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<Vertex, Key> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        if constexpr (MergePolicy::auxiliary) {
+            if (aux) {
+                root = pairing_merge::link(root, MergePolicy::combine_aux(aux));
+                aux = nullptr;
+                aux_min = nullptr;
+            }
+        }
+
+        Node* old_root = root;
+        Vertex vertex = old_root->vertex;
+        Key key = old_root->key;
+
+        root = MergePolicy::combine(old_root->child);
+        delete old_root;
+        n--;
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {vertex, key};
+    }
+
+    // Decrease the priority of a previously inserted node
+    void decrease_key(Handle* node, Key new_key) {
+        auto start = std::chrono::high_resolution_clock::now();
+        decrease_key_count++;
+
+        if (new_key >= node->key) {
+            auto end = std::chrono::high_resolution_clock::now();
+            decrease_key_time_ns += static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
+            return;
+        }
+
+        node->key = new_key;
+
+        if (!node->prev) {
+            // Already a root (main root or auxiliary list entry)
+            if (MergePolicy::auxiliary && node != root && new_key < aux_min->key)
+                aux_min = node;
+        } else {
+            // O(1) detach: prev is either the parent or the left sibling
+            if (node->prev->child == node)
+                node->prev->child = node->next;
+            else
+                node->prev->next = node->next;
+            if (node->next)
+                node->next->prev = node->prev;
+            node->next = nullptr;
+            node->prev = nullptr;
+
+            add_root(node);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        decrease_key_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
+    }
+
+    bool empty() const { return n == 0; }
+    int size() const { return n; }
+
+    std::pair<Vertex, Key> find_min() const {
+        const Node* m = root;
+        if (MergePolicy::auxiliary && aux_min && (!m || aux_min->key < m->key))
+            m = aux_min;
+        return {m->vertex, m->key};
+    }
+
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        delete_all(root);
+        delete_all(aux);
+        root = nullptr;
+        aux = nullptr;
+        aux_min = nullptr;
+        n = 0;
+    }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return MergePolicy::name(); }
+
+private:
+    Node* root;
+    Node* aux;     // auxiliary root list (AuxTwoPass only), linked through next
+    Node* aux_min; // minimum of the auxiliary list
+    int n;
+
+    void add_root(Node* node) {
+        if constexpr (MergePolicy::auxiliary) {
+            node->next = aux;
+            aux = node;
+            if (!aux_min || node->key < aux_min->key)
+                aux_min = node;
+        } else {
+            root = pairing_merge::link(root, node);
+        }
+    }
+
+    // Iterative teardown; the recursive version overflows on wide sibling lists
+    static void delete_all(Node* node) {
+        std::vector<Node*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node* curr = stack.back();
+            stack.pop_back();
+            if (curr->child) stack.push_back(curr->child);
+            if (curr->next) stack.push_back(curr->next);
+            delete curr;
+        }
+    }
+};
+
+using PairingHeapTwoPass     = PolicyPairingHeap<pairing_merge::TwoPass>;
+using PairingHeapMultipass   = PolicyPairingHeap<pairing_merge::Multipass>;
+using PairingHeapAuxTwoPass  = PolicyPairingHeap<pairing_merge::AuxTwoPass>;
+using PairingHeapBackToFront = PolicyPairingHeap<pairing_merge::BackToFront>;
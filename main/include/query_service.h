@@ -0,0 +1,183 @@
+#pragma once
+// In-process shortest-path query service with a shortest-path-tree cache
+// Holds one graph and answers distance / path queries. A query from a source
+// that was searched recently is answered from that source's cached tree;
+// otherwise a Dijkstra search runs (on a reused SearchWorkspace) and its tree
+// is cached. Trees are stored compactly (float distances + vertex parents,
+// 8 bytes per vertex for the default types) in an LRU bounded by a byte
+// budget; a budget below one tree disables caching.
+// Float distances carry ~7 significant digits, so cached answers can differ
+// from a fresh search in the last bits; paths are exact.
+// Every call records its latency; stats() and latency() expose hit rate and
+// percentiles. Not thread-safe: use one service per thread.
+
+#include "graph.h"
+#include "algorithms.h"
+#include "binary_heap.h"
+#include "search_workspace.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Per-call latencies in nanoseconds, with percentiles over all samples
+class LatencyRecorder {
+public:
+    void add(double ns) {
+        samples.push_back(ns);
+        sorted = false;
+    }
+
+    std::size_t count() const { return samples.size(); }
+
+    double mean() const {
+        double sum = 0;
+        for (double s : samples) sum += s;
+        return samples.empty() ? 0.0 : sum / samples.size();
+    }
+
+    // p in [0, 100], nearest-rank
+    double percentile(double p) const {
+        if (samples.empty()) return 0.0;
+        if (!sorted) {
+            std::sort(samples.begin(), samples.end());
+            sorted = true;
+        }
+        std::size_t rank = static_cast<std::size_t>(p / 100.0 * samples.size());
+        return samples[std::min(rank, samples.size() - 1)];
+    }
+
+    void clear() { samples.clear(); }
+
+private:
+    mutable std::vector<double> samples;
+    mutable bool sorted = false;
+};
+
+struct QueryStats {
+    std::uint64_t queries = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+
+    double hit_rate() const { return queries ? static_cast<double>(hits) / queries : 0.0; }
+};
+
+template<typename Heap = BinaryHeap, typename G = Graph>
+class QueryService {
+public:
+    using Vertex = typename G::Vertex;
+    using Weight = typename G::Weight;
+
+    // cache_bytes: budget for cached trees (tree_bytes() each)
+    QueryService(G graph, std::size_t cache_bytes)
+        : g(std::move(graph)), ws(g.size()),
+          capacity(cache_bytes / std::max<std::size_t>(1, tree_bytes())) {}
+
+    // Shortest distance from source to target (+inf if unreachable)
+    double distance(Vertex source, Vertex target) {
+        auto start = std::chrono::high_resolution_clock::now();
+        double d;
+        if (const Tree* t = lookup(source)) {
+            d = static_cast<double>(t->dist[target]);
+        } else {
+            Weight w = ws.dist(target);
+            d = w == infinite_weight<Weight>() ? std::numeric_limits<double>::infinity()
+                                               : static_cast<double>(w);
+        }
+        record(start);
+        return d;
+    }
+
+    // Vertices on a shortest path source .. target (empty if unreachable)
+    std::vector<Vertex> path(Vertex source, Vertex target) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Vertex> out;
+        const Tree* t = lookup(source);
+        auto parent = [&](Vertex v) { return t ? t->parent[v] : ws.parent(v); };
+        if (target == source || parent(target) != no_vertex<Vertex>()) {
+            for (Vertex v = target; v != no_vertex<Vertex>(); v = parent(v))
+                out.push_back(v);
+            std::reverse(out.begin(), out.end());
+        }
+        record(start);
+        return out;
+    }
+
+    std::size_t tree_bytes() const {
+        return static_cast<std::size_t>(g.size()) * (sizeof(float) + sizeof(Vertex));
+    }
+    std::size_t cache_capacity() const { return capacity; }   // trees
+    std::size_t cached_trees() const { return lru.size(); }
+    std::size_t cache_bytes() const { return lru.size() * tree_bytes(); }
+
+    const QueryStats& stats() const { return query_stats; }
+    const LatencyRecorder& latency() const { return latencies; }
+    void reset_stats() {
+        query_stats = QueryStats();
+        latencies.clear();
+    }
+
+    const G& graph() const { return g; }
+
+private:
+    struct Tree {
+        Vertex source;
+        std::vector<float> dist;
+        std::vector<Vertex> parent;
+    };
+
+    G g;
+    SearchWorkspace<Heap> ws;
+    std::size_t capacity;
+    std::list<Tree> lru; // most recently used first
+    std::unordered_map<Vertex, typename std::list<Tree>::iterator> index;
+    QueryStats query_stats;
+    LatencyRecorder latencies;
+
+    // Cached tree for source, or nullptr when caching is off (the search
+    // result is then read from the workspace). Misses search and cache.
+    const Tree* lookup(Vertex source) {
+        query_stats.queries++;
+        auto it = index.find(source);
+        if (it != index.end()) {
+            query_stats.hits++;
+            lru.splice(lru.begin(), lru, it->second);
+            return &lru.front();
+        }
+
+        query_stats.misses++;
+        dijkstra(g, source, ws);
+        if (capacity == 0) return nullptr;
+
+        // Reuse the least recently used tree's buffers when full
+        if (lru.size() == capacity) {
+            index.erase(lru.back().source);
+            lru.splice(lru.begin(), lru, std::prev(lru.end()));
+            query_stats.evictions++;
+        } else {
+            lru.emplace_front();
+        }
+        Tree& t = lru.front();
+        t.source = source;
+        t.dist.assign(static_cast<std::size_t>(g.size()), std::numeric_limits<float>::infinity());
+        t.parent.assign(static_cast<std::size_t>(g.size()), no_vertex<Vertex>());
+        for (Vertex v : ws.touched()) {
+            Weight d = ws.dist(v);
+            if (d != infinite_weight<Weight>()) t.dist[v] = static_cast<float>(d);
+            t.parent[v] = ws.parent(v);
+        }
+        index[source] = lru.begin();
+        return &t;
+    }
+
+    void record(std::chrono::high_resolution_clock::time_point start) {
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies.add(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+};
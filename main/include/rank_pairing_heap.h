@@ -0,0 +1,289 @@
+#pragma once
+// Rank-Pairing Heap (Haeupler, Sen & Tarjan) for graph algorithms
+// Heap-ordered half trees kept in a root list; extract-min uses one-pass
+// linking by rank, decrease-key cuts the node out and repairs ranks on the
+// path to the root. The rank rule is a template parameter:
+//   type 1: rank = max(r1, r2) if r1 != r2, else r1 + 1
+//   type 2: rank = max(r1, r2) if |r1 - r2| > 1, else max(r1, r2) + 1
+// (missing children have rank -1; a root's rank is its left child's rank + 1)
+// Supports: insert (returns handle), extract-min, decrease-key, find-min
+// Includes built-in metrics tracking for benchmarking
+// Key and vertex-id types are trailing template parameters (default double/int)
+
+#include "trace.h"
+#include "latency_histogram.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+
+template<int RankType, typename KeyT = double, typename VertexT = int>
+class RankPairingHeap {
+    static_assert(RankType == 1 || RankType == 2, "rank rule must be type 1 or 2");
+
+public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
+    struct Node {
+        Key key;
+        Vertex vertex;
+        int rank;
+        Node* left;   // first child in the half tree
+        Node* right;  // next sibling; for roots, the next root in the root list
+        Node* parent; // nullptr for roots
+
+        Node(Key k, Vertex v)
+            : key(k), vertex(v), rank(0),
+              left(nullptr), right(nullptr), parent(nullptr) {}
+    };
+
+    using Handle = Node;
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0;
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    RankPairingHeap() : min_node(nullptr), n(0) {}
+
+    ~RankPairingHeap() { clear(); }
+
+    RankPairingHeap(const RankPairingHeap&) = delete;
+    RankPairingHeap& operator=(const RankPairingHeap&) = delete;
+
+    // Insert a vertex with given priority; returns a handle for decrease-key
+    Handle* insert(Vertex vertex, Key priority) {
+        insert_count++;
+        Node* node = new Node(priority, vertex);
+        add_root(node);
+        n++;
+        return node;
+    }
+
+    // Bulk-load (vertex, priority) pairs as rank-0 roots in O(n); the first
+    // extract-min links them in one pass. Returns handles in the order of items
+    std::vector<Handle*> build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        std::vector<Handle*> handles;
+        handles.reserve(items.size());
+        for (const auto& [vertex, priority] : items) {
+            Node* node = new Node(priority, vertex);
+            add_root(node);
+            handles.push_back(node);
+        }
+        n += static_cast<int>(items.size());
+        return handles;
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<Vertex, Key> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        Node* z = min_node;
+        Vertex vertex = z->vertex;
+        Key key = z->key;
+
+        // Unroll the remaining roots into a nullptr-terminated list, then add
+        // every node on the right spine of z's left child as a new root
+        Node* roots = nullptr;
+        for (Node* r = z->right; r != z;) {
+            Node* next = r->right;
+            r->right = roots;
+            roots = r;
+            r = next;
+        }
+        Node* spine = z->left;
+        while (spine) {
+            Node* next = spine->right;
+            spine->parent = nullptr;
+            spine->rank = spine->left ? spine->left->rank + 1 : 0;
+            spine->right = roots;
+            roots = spine;
+            spine = next;
+        }
+
+        delete z;
+        n--;
+        min_node = nullptr;
+        one_pass_link(roots);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {vertex, key};
+    }
+
+    // Decrease the priority of a previously inserted node
+    void decrease_key(Handle* node, Key new_key) {
+        auto start = std::chrono::high_resolution_clock::now();
+        decrease_key_count++;
+
+        if (new_key >= node->key) {
+            auto end = std::chrono::high_resolution_clock::now();
+            decrease_key_time_ns += static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            trace::heap_op("decrease_key", start, end);
+            decrease_key_latency.record(start, end);
+            return;
+        }
+
+        node->key = new_key;
+
+        if (!node->parent) {
+            if (node->key < min_node->key)
+                min_node = node;
+        } else {
+            // Cut node (with its left subtree); its right subtree takes its place
+            Node* parent = node->parent;
+            Node* sub = node->right;
+            if (parent->left == node)
+                parent->left = sub;
+            else
+                parent->right = sub;
+            if (sub) sub->parent = parent;
+
+            node->parent = nullptr;
+            node->rank = node->left ? node->left->rank + 1 : 0;
+            add_root(node);
+
+            repair_ranks(parent);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        decrease_key_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("decrease_key", start, end);
+        decrease_key_latency.record(start, end);
+    }
+
+    bool empty() const { return min_node == nullptr; }
+    int size() const { return n; }
+
+    std::pair<Vertex, Key> find_min() const {
+        return {min_node->vertex, min_node->key};
+    }
+
+    // Remove all elements (outstanding handles become invalid); metrics are kept
+    void clear() {
+        if (min_node) {
+            Node* first = min_node->right;
+            min_node->right = nullptr; // break the circular root list
+            delete_all(first);
+        }
+        min_node = nullptr;
+        n = 0;
+    }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return RankType == 1 ? "RankPairing1" : "RankPairing2"; }
+
+private:
+    // Root list is circular, linked through right, entered at min_node
+    Node* min_node;
+    int n;
+    std::vector<Node*> buckets; // one-pass linking table, indexed by rank
+
+    void add_root(Node* node) {
+        if (!min_node) {
+            node->right = node;
+            min_node = node;
+        } else {
+            node->right = min_node->right;
+            min_node->right = node;
+            if (node->key < min_node->key)
+                min_node = node;
+        }
+    }
+
+    // Link two half-tree roots of equal rank; the loser becomes the left child
+    static Node* link(Node* a, Node* b) {
+        if (b->key < a->key) std::swap(a, b);
+        b->right = a->left;
+        if (b->right) b->right->parent = b;
+        a->left = b;
+        b->parent = a;
+        a->rank = b->rank + 1;
+        return a;
+    }
+
+    // One-pass linking: each root is linked at most once, with whichever
+    // root of equal rank is waiting in the bucket table
+    void one_pass_link(Node* roots) {
+        while (roots) {
+            Node* r = roots;
+            roots = roots->right;
+            if (r->rank >= static_cast<int>(buckets.size()))
+                buckets.resize(r->rank + 1, nullptr);
+            Node* other = buckets[r->rank];
+            if (!other) {
+                buckets[r->rank] = r;
+            } else {
+                buckets[r->rank] = nullptr;
+                add_root(link(other, r));
+            }
+        }
+        for (Node*& b : buckets) {
+            if (b) {
+                add_root(b);
+                b = nullptr;
+            }
+        }
+    }
+
+    static int rank_of(const Node* node) { return node ? node->rank : -1; }
+
+    // Walk up from a node that lost a child, lowering ranks per the rank rule
+    static void repair_ranks(Node* y) {
+        while (y) {
+            if (!y->parent) {
+                y->rank = rank_of(y->left) + 1;
+                return;
+            }
+            int r1 = rank_of(y->left);
+            int r2 = rank_of(y->right);
+            int k;
+            if (RankType == 1)
+                k = (r1 != r2) ? std::max(r1, r2) : r1 + 1;
+            else
+                k = (std::abs(r1 - r2) > 1) ? std::max(r1, r2) : std::max(r1, r2) + 1;
+            if (k >= y->rank) return;
+            y->rank = k;
+            y = y->parent;
+        }
+    }
+
+    // Iterative teardown over left/right pointers (covers the root list too)
+    static void delete_all(Node* node) {
+        std::vector<Node*> stack;
+        if (node) stack.push_back(node);
+        while (!stack.empty()) {
+            Node* curr = stack.back();
+            stack.pop_back();
+            if (curr->left) stack.push_back(curr->left);
+            if (curr->right) stack.push_back(curr->right);
+            delete curr;
+        }
+    }
+};
+
+using RankPairingHeap1 = RankPairingHeap<1>;
+using RankPairingHeap2 = RankPairingHeap<2>;
@@ -0,0 +1,215 @@
+#pragma once
+// Locality-improving vertex reordering
+// The numbering of vertices decides how dist / handle arrays and adjacency
+// lists are touched during a search: neighbours with nearby ids share cache
+// lines and pages. Each *_order function computes a permutation, and
+// permute_graph applies it. Results computed on the permuted graph are
+// translated back with map_back / map_back_vertices.
+//   bfs_order           - breadth-first discovery order
+//   cuthill_mckee_order - BFS from a low-degree vertex, neighbours by increasing
+//                         degree; reversed (RCM) by default for lower bandwidth
+//   degree_order        - high-degree vertices first (hubs share a few pages)
+//   hilbert_order       - Hilbert curve over grid coordinates (grid_graph layout)
+//   shuffled_order      - random permutation; models an arbitrary input numbering
+
+#include "graph.h"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+
+template<typename Vertex = int>
+struct BasicVertexOrder {
+    std::vector<Vertex> new_id; // new_id[original vertex] = vertex in the permuted graph
+    std::vector<Vertex> old_id; // old_id[permuted vertex] = original vertex
+};
+
+using VertexOrder = BasicVertexOrder<>;
+
+// Build a permutation from a sequence listing the original vertices in their new order
+template<typename Vertex>
+BasicVertexOrder<Vertex> order_from_sequence(std::vector<Vertex> sequence) {
+    BasicVertexOrder<Vertex> order;
+    order.new_id.resize(sequence.size());
+    for (std::size_t i = 0; i < sequence.size(); i++)
+        order.new_id[sequence[i]] = static_cast<Vertex>(i);
+    order.old_id = std::move(sequence);
+    return order;
+}
+
+template<typename G>
+BasicVertexOrder<typename G::Vertex> identity_order(const G& g) {
+    std::vector<typename G::Vertex> seq(static_cast<std::size_t>(g.size()));
+    std::iota(seq.begin(), seq.end(), typename G::Vertex(0));
+    return order_from_sequence(std::move(seq));
+}
+
+template<typename G>
+BasicVertexOrder<typename G::Vertex> shuffled_order(const G& g, int seed = 42) {
+    std::vector<typename G::Vertex> seq(static_cast<std::size_t>(g.size()));
+    std::iota(seq.begin(), seq.end(), typename G::Vertex(0));
+    std::mt19937 rng(seed);
+    std::shuffle(seq.begin(), seq.end(), rng);
+    return order_from_sequence(std::move(seq));
+}
+
+// Breadth-first order from start; other components follow in id order
+template<typename G>
+BasicVertexOrder<typename G::Vertex> bfs_order(const G& g, typename G::Vertex start = 0) {
+    using Vertex = typename G::Vertex;
+    const std::size_t n = static_cast<std::size_t>(g.size());
+    std::vector<Vertex> seq;
+    seq.reserve(n);
+    std::vector<bool> seen(n, false);
+
+    auto bfs_from = [&](Vertex s) {
+        std::size_t head = seq.size();
+        seen[s] = true;
+        seq.push_back(s);
+        while (head < seq.size()) {
+            Vertex u = seq[head++];
+            for (const auto& e : g.adj[u]) {
+                if (!seen[e.to]) {
+                    seen[e.to] = true;
+                    seq.push_back(e.to);
+                }
+            }
+        }
+    };
+
+    if (n > 0) bfs_from(start);
+    for (std::size_t v = 0; v < n; v++)
+        if (!seen[v]) bfs_from(static_cast<Vertex>(v));
+    return order_from_sequence(std::move(seq));
+}
+
+// Cuthill-McKee: each component starts at its lowest-degree vertex and
+// neighbours are enqueued by increasing degree
+template<typename G>
+BasicVertexOrder<typename G::Vertex> cuthill_mckee_order(const G& g, bool reverse = true) {
+    using Vertex = typename G::Vertex;
+    const std::size_t n = static_cast<std::size_t>(g.size());
+    auto degree = [&](Vertex v) { return g.adj[v].size(); };
+
+    // Component start candidates: all vertices by increasing degree
+    std::vector<Vertex> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), Vertex(0));
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&](Vertex a, Vertex b) { return degree(a) < degree(b); });
+
+    std::vector<Vertex> seq;
+    seq.reserve(n);
+    std::vector<bool> seen(n, false);
+    std::vector<Vertex> neighbours;
+
+    for (Vertex s : by_degree) {
+        if (seen[s]) continue;
+        std::size_t head = seq.size();
+        seen[s] = true;
+        seq.push_back(s);
+        while (head < seq.size()) {
+            Vertex u = seq[head++];
+            neighbours.clear();
+            for (const auto& e : g.adj[u])
+                if (!seen[e.to]) {
+                    seen[e.to] = true;
+                    neighbours.push_back(e.to);
+                }
+            std::sort(neighbours.begin(), neighbours.end(), [&](Vertex a, Vertex b) {
+                return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+            });
+            seq.insert(seq.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    if (reverse) std::reverse(seq.begin(), seq.end());
+    return order_from_sequence(std::move(seq));
+}
+
+// Descending degree; ties keep their original relative order
+template<typename G>
+BasicVertexOrder<typename G::Vertex> degree_order(const G& g) {
+    using Vertex = typename G::Vertex;
+    std::vector<Vertex> seq(static_cast<std::size_t>(g.size()));
+    std::iota(seq.begin(), seq.end(), Vertex(0));
+    std::stable_sort(seq.begin(), seq.end(), [&](Vertex a, Vertex b) {
+        return g.adj[a].size() > g.adj[b].size();
+    });
+    return order_from_sequence(std::move(seq));
+}
+
+// Distance of (x, y) along the Hilbert curve filling a side x side square
+// (side a power of two)
+inline std::uint64_t hilbert_index(std::uint64_t side, std::uint64_t x, std::uint64_t y) {
+    std::uint64_t d = 0;
+    for (std::uint64_t s = side / 2; s > 0; s /= 2) {
+        std::uint64_t rx = (x & s) ? 1 : 0;
+        std::uint64_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Hilbert order for GraphGenerator::grid_graph's layout (vertex r * cols + c)
+template<typename Vertex = int>
+BasicVertexOrder<Vertex> hilbert_order(int rows, int cols) {
+    std::uint64_t side = 1;
+    while (side < static_cast<std::uint64_t>(std::max(rows, cols))) side *= 2;
+
+    std::vector<std::pair<std::uint64_t, Vertex>> keyed;
+    keyed.reserve(static_cast<std::size_t>(rows) * cols);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++)
+            keyed.push_back({hilbert_index(side, c, r), static_cast<Vertex>(r * cols + c)});
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<Vertex> seq;
+    seq.reserve(keyed.size());
+    for (const auto& kv : keyed) seq.push_back(kv.second);
+    return order_from_sequence(std::move(seq));
+}
+
+// Copy of g with every vertex renamed to order.new_id (edge lists keep their order)
+template<typename G>
+G permute_graph(const G& g, const BasicVertexOrder<typename G::Vertex>& order) {
+    G out(g.size());
+    for (std::size_t u = 0; u < g.adj.size(); u++) {
+        auto& edges = out.adj[order.new_id[u]];
+        edges.reserve(g.adj[u].size());
+        for (const auto& e : g.adj[u])
+            edges.push_back({order.new_id[e.to], e.weight});
+    }
+    return out;
+}
+
+// Per-vertex values from the permuted graph, re-indexed by original vertex
+template<typename T, typename Vertex>
+std::vector<T> map_back(const std::vector<T>& values, const BasicVertexOrder<Vertex>& order) {
+    std::vector<T> out(values.size());
+    for (std::size_t v = 0; v < values.size(); v++)
+        out[v] = values[order.new_id[v]];
+    return out;
+}
+
+// Like map_back for arrays holding vertex ids (e.g. parents): the ids are
+// translated to original vertices as well; no_vertex stays no_vertex
+template<typename Vertex>
+std::vector<Vertex> map_back_vertices(const std::vector<Vertex>& ids,
+                                      const BasicVertexOrder<Vertex>& order) {
+    std::vector<Vertex> out(ids.size());
+    for (std::size_t v = 0; v < ids.size(); v++) {
+        Vertex id = ids[order.new_id[v]];
+        out[v] = id == no_vertex<Vertex>() ? id : order.old_id[id];
+    }
+    return out;
+}
@@ -0,0 +1,276 @@
+#pragma once
+// Single search engine behind Dijkstra and Prim
+// Every public entry point in algorithms.h and every benchmark run in
+// benchmark.h goes through these loops, so the code that is measured is the
+// code that ships. Three extension points keep it generic:
+//   Labels  - where per-vertex state lives (DenseLabels below, or a reusable
+//             SearchWorkspace); both expose the same accessors
+//   Visitor - instrumentation hooks (phase timers, counters, callbacks).
+//             NullSearchVisitor's hooks are empty inline functions, so the
+//             uninstrumented instantiation compiles to the bare loop.
+//   Stop    - early-termination rule for Dijkstra (radius, k settled, target
+//             set; see bounded_search.h). NeverStop runs to completion.
+// Keys and vertex ids take the heap's Key / Vertex types, which must match the
+// graph's Weight / Vertex types; unreached vertices hold infinite_weight<Key>().
+
+#include "graph.h"
+#include "simd_relax.h"
+#include <vector>
+#include <utility>
+#include <limits>
+#include <type_traits>
+#include <cstddef>
+#include <algorithm>
+
+// How vertices enter the heap:
+//   Eager - every vertex is inserted up front (source with key 0, the rest with INF)
+//   Lazy  - a vertex is inserted when it is first discovered, and later improvements
+//           use decrease-key; handles[v] == nullptr marks an undiscovered vertex
+enum class InsertMode { Eager, Lazy };
+
+// (vertex, key) pairs for eager initialization: every vertex at INF except start,
+// indexed by vertex so the handles returned by Heap::build line up with it
+template<typename Key = double, typename Vertex = int>
+std::vector<std::pair<Vertex, Key>> initial_keys(Vertex n, Vertex start) {
+    const Key INF = infinite_weight<Key>();
+    std::vector<std::pair<Vertex, Key>> items(static_cast<std::size_t>(n));
+    for (Vertex v = 0; v < n; v++)
+        items[v] = {v, v == start ? Key(0) : INF};
+    return items;
+}
+
+// Visitor with no-op hooks; also documents the hook interface
+struct NullSearchVisitor {
+    void on_init_begin() {}
+    void on_init_end(std::size_t /*heap_size*/) {}
+    void on_insert(std::size_t /*heap_size*/) {}
+    template<typename Vertex, typename Key>
+    void on_settle(Vertex /*vertex*/, Key /*key*/) {}
+    template<typename Vertex, typename Key>
+    void on_improve(Vertex /*vertex*/, Key /*key*/, Vertex /*parent*/) {}
+    void on_search_end() {}
+};
+
+// Stop rule that never fires; also documents the interface. before_settle
+// can end the search before u is settled (u stays unsettled), after_settle
+// once u is settled but before its edges are relaxed.
+struct NeverStop {
+    template<typename Vertex, typename Key>
+    bool before_settle(Vertex /*vertex*/, Key /*key*/) { return false; }
+    template<typename Vertex, typename Key>
+    bool after_settle(Vertex /*vertex*/, Key /*key*/) { return false; }
+};
+
+// Plain per-query vectors, sized to the graph. Handle = void skips the
+// handle array (lazy-deletion queues have no handles).
+template<typename Handle, typename Key = double, typename Vertex = int>
+class DenseLabels {
+public:
+    explicit DenseLabels(Vertex n)
+        : dist_(static_cast<std::size_t>(n), infinite_weight<Key>()),
+          parent_(static_cast<std::size_t>(n), no_vertex<Vertex>()),
+          handles_(std::is_void<Handle>::value ? 0 : static_cast<std::size_t>(n), nullptr),
+          visited_(static_cast<std::size_t>(n), false) {}
+
+    Key dist(Vertex v) const { return dist_[v]; }
+    Vertex parent(Vertex v) const { return parent_[v]; }
+    Handle* handle(Vertex v) const { return handles_[v]; }
+    bool visited(Vertex v) const { return visited_[v]; }
+
+    void set_label(Vertex v, Key d, Vertex p) {
+        dist_[v] = d;
+        parent_[v] = p;
+    }
+    void set_handle(Vertex v, Handle* h) { handles_[v] = h; }
+    void set_handles(std::vector<Handle*>&& handles) { handles_ = std::move(handles); }
+    void mark_visited(Vertex v) { visited_[v] = true; }
+
+    // Contiguous dist array for the vectorized relaxation kernels
+    const Key* dist_data() const { return dist_.data(); }
+
+    std::vector<Key> take_dist() { return std::move(dist_); }
+    std::vector<Vertex> take_parent() { return std::move(parent_); }
+
+private:
+    std::vector<Key> dist_;
+    std::vector<Vertex> parent_;
+    std::vector<Handle*> handles_;
+    std::vector<bool> visited_;
+};
+
+// Populate the heap: all vertices via Heap::build (eager) or only start (lazy)
+template<typename Heap, typename Labels, typename Visitor>
+void init_search(typename Heap::Vertex n, typename Heap::Vertex start, InsertMode mode,
+                 Heap& heap, Labels& labels, Visitor& vis) {
+    using Key = typename Heap::Key;
+    using Vertex = typename Heap::Vertex;
+    vis.on_init_begin();
+    labels.set_label(start, Key(0), no_vertex<Vertex>());
+    if (mode == InsertMode::Eager)
+        labels.set_handles(heap.build(initial_keys<Key>(n, start)));
+    else
+        labels.set_handle(start, heap.insert(start, Key(0)));
+    vis.on_init_end(static_cast<std::size_t>(heap.size()));
+}
+
+// The heap's key / id types must be the graph's weight / id types
+template<typename G, typename Heap>
+constexpr void check_search_types() {
+    static_assert(std::is_same<typename Heap::Key, typename G::Weight>::value,
+                  "heap key type must match graph weight type");
+    static_assert(std::is_same<typename Heap::Vertex, typename G::Vertex>::value,
+                  "heap vertex type must match graph vertex type");
+}
+
+// Record an improved key for v: decrease-key if v is in the heap, else insert it
+template<typename Heap, typename Labels, typename Visitor>
+inline void improve_key(typename Heap::Vertex v, typename Heap::Key key, typename Heap::Vertex parent,
+                        Heap& heap, Labels& labels, Visitor& vis) {
+    labels.set_label(v, key, parent);
+    vis.on_improve(v, key, parent);
+    if (auto* h = labels.handle(v)) {
+        heap.decrease_key(h, key);
+    } else {
+        labels.set_handle(v, heap.insert(v, key));
+        vis.on_insert(static_cast<std::size_t>(heap.size()));
+    }
+}
+
+// Relax all edges of u through the active SIMD kernel, block by block. The
+// kernel only filters by key; each candidate is re-checked here because an
+// earlier candidate (parallel edge) or a settled vertex may rule it out.
+// Edges is any contiguous range of Edge (std::vector, CSR neighbour range).
+template<typename Edges, typename Heap, typename Labels, typename Visitor>
+void relax_edges_simd(const Edges& edges, int u, double base,
+                      Heap& heap, Labels& labels, Visitor& vis) {
+    simd_relax::KernelFn kernel = simd_relax::kernel_fn(simd_relax::active_kernel());
+    int cand_v[simd_relax::block];
+    double cand_d[simd_relax::block];
+
+    for (std::size_t i = 0; i < edges.size(); i += simd_relax::block) {
+        std::size_t count = std::min(simd_relax::block, edges.size() - i);
+        std::size_t m = kernel(edges.data() + i, count, base, labels.dist_data(), cand_v, cand_d);
+        for (std::size_t j = 0; j < m; j++) {
+            int v = cand_v[j];
+            if (!labels.visited(v) && cand_d[j] < labels.dist(v))
+                improve_key(v, cand_d[j], u, heap, labels, vis);
+        }
+    }
+}
+
+// True when u's edges should go through relax_edges_simd
+template<typename G, typename Labels>
+inline bool use_simd_relax(const G& g, typename G::Vertex u) {
+    if constexpr (simd_relax::eligible<G, Labels>::value)
+        return simd_relax::active_kernel() != simd_relax::Kernel::Scalar &&
+               g.adj[u].size() >= simd_relax::min_degree;
+    else
+        return false;
+}
+
+// Dijkstra's main loop (non-negative weights)
+template<typename G, typename Heap, typename Labels, typename Visitor, typename Stop = NeverStop>
+void dijkstra_search(const G& g, typename G::Vertex source, InsertMode mode,
+                     Heap& heap, Labels& labels, Visitor& vis, Stop stop = Stop()) {
+    check_search_types<G, Heap>();
+    using Key = typename Heap::Key;
+    const Key INF = infinite_weight<Key>();
+    init_search(g.size(), source, mode, heap, labels, vis);
+
+    while (!heap.empty()) {
+        auto [u, d] = heap.extract_min();
+        if (stop.before_settle(u, d)) break;
+        labels.mark_visited(u);
+
+        if (d == INF) break; // remaining vertices unreachable
+        vis.on_settle(u, d);
+        if (stop.after_settle(u, d)) break;
+
+        if constexpr (simd_relax::eligible<G, Labels>::value) {
+            if (use_simd_relax<G, Labels>(g, u)) {
+                relax_edges_simd(g.adj[u], u, d, heap, labels, vis);
+                continue;
+            }
+        }
+        for (const auto& edge : g.adj[u]) {
+            auto v = edge.to;
+            if (!labels.visited(v)) {
+                Key new_dist = d + edge.weight;
+                if (new_dist < labels.dist(v))
+                    improve_key(v, new_dist, u, heap, labels, vis);
+            }
+        }
+    }
+    vis.on_search_end();
+}
+
+// Prim's main loop, grown from root; labels.dist holds connecting edge weights.
+// Returns the weight of the spanning tree of root's component.
+template<typename G, typename Heap, typename Labels, typename Visitor>
+double prim_search(const G& g, typename G::Vertex root, InsertMode mode,
+                   Heap& heap, Labels& labels, Visitor& vis) {
+    check_search_types<G, Heap>();
+    using Key = typename Heap::Key;
+    const Key INF = infinite_weight<Key>();
+    double total_weight = 0.0;
+    init_search(g.size(), root, mode, heap, labels, vis);
+
+    while (!heap.empty()) {
+        auto [u, d] = heap.extract_min();
+        labels.mark_visited(u);
+
+        if (d == INF) break; // remaining vertices not reachable
+        total_weight += d;
+        vis.on_settle(u, d);
+
+        if constexpr (simd_relax::eligible<G, Labels>::value) {
+            if (use_simd_relax<G, Labels>(g, u)) {
+                relax_edges_simd(g.adj[u], u, 0.0, heap, labels, vis);
+                continue;
+            }
+        }
+        for (const auto& edge : g.adj[u]) {
+            auto v = edge.to;
+            if (!labels.visited(v) && edge.weight < labels.dist(v))
+                improve_key(v, edge.weight, u, heap, labels, vis);
+        }
+    }
+    vis.on_search_end();
+    return total_weight;
+}
+
+// Lazy-deletion Dijkstra: no handles or decrease-key. A vertex is inserted again
+// whenever its distance improves and stale entries are skipped on extraction.
+template<typename G, typename Queue, typename Labels, typename Visitor, typename Stop = NeverStop>
+void dijkstra_lazy_search(const G& g, typename G::Vertex source,
+                          Queue& queue, Labels& labels, Visitor& vis, Stop stop = Stop()) {
+    check_search_types<G, Queue>();
+    using Key = typename Queue::Key;
+    vis.on_init_begin();
+    labels.set_label(source, Key(0), no_vertex<typename G::Vertex>());
+    queue.insert(source, Key(0));
+    vis.on_init_end(1);
+
+    while (!queue.empty()) {
+        auto [u, d] = queue.extract_min();
+        if (labels.visited(u) || d > labels.dist(u)) continue; // stale entry
+        if (stop.before_settle(u, d)) break;
+        labels.mark_visited(u);
+        vis.on_settle(u, d);
+        if (stop.after_settle(u, d)) break;
+
+        for (const auto& edge : g.adj[u]) {
+            auto v = edge.to;
+            if (!labels.visited(v)) {
+                Key new_dist = d + edge.weight;
+                if (new_dist < labels.dist(v)) {
+                    labels.set_label(v, new_dist, u);
+                    vis.on_improve(v, new_dist, u);
+                    queue.insert(v, new_dist);
+                    vis.on_insert(static_cast<std::size_t>(queue.size()));
+                }
+            }
+        }
+    }
+    vis.on_search_end();
+}
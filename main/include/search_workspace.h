@@ -0,0 +1,101 @@
+#pragma once
+// Reusable per-graph search state for repeated Dijkstra / Prim queries
+// Owns the dist, parent, handle and visited arrays plus the heap, so a query
+// does not allocate or zero O(V) memory. Entries are validated by epoch
+// counters: reset() just advances the epoch, and a vertex's state reads as
+// (INF, -1, no handle, unvisited) until it is touched in the current query.
+// The touched list records every vertex written in the current query.
+// Keys and ids use the heap's Key / Vertex types.
+
+#include "graph.h"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+template<typename Heap>
+class SearchWorkspace {
+public:
+    using Handle = typename Heap::Handle;
+    using Key = typename Heap::Key;
+    using Vertex = typename Heap::Vertex;
+
+    explicit SearchWorkspace(Vertex n)
+        : num_vertices(n), epoch(1),
+          dist_(static_cast<std::size_t>(n)), parent_(static_cast<std::size_t>(n)),
+          handles_(static_cast<std::size_t>(n)), stamp_(static_cast<std::size_t>(n), 0),
+          visited_stamp_(static_cast<std::size_t>(n), 0) {}
+
+    Vertex size() const { return num_vertices; }
+
+    // Start a new query: O(1) apart from releasing nodes left in the heap
+    void reset() {
+        heap_.clear();
+        touched_.clear();
+        if (++epoch == 0) {
+            // Epoch counter wrapped; clear stamps once so stale entries can't match
+            std::fill(stamp_.begin(), stamp_.end(), 0);
+            std::fill(visited_stamp_.begin(), visited_stamp_.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    Key dist(Vertex v) const {
+        return stamp_[v] == epoch ? dist_[v] : infinite_weight<Key>();
+    }
+
+    Vertex parent(Vertex v) const { return stamp_[v] == epoch ? parent_[v] : no_vertex<Vertex>(); }
+
+    Handle* handle(Vertex v) const { return stamp_[v] == epoch ? handles_[v] : nullptr; }
+
+    bool visited(Vertex v) const { return visited_stamp_[v] == epoch; }
+
+    // Record a tentative label for v (first write in a query adds v to touched)
+    void set_label(Vertex v, Key d, Vertex p) {
+        touch(v);
+        dist_[v] = d;
+        parent_[v] = p;
+    }
+
+    void set_handle(Vertex v, Handle* h) {
+        touch(v);
+        handles_[v] = h;
+    }
+
+    // Handles from Heap::build, indexed by vertex (eager initialization)
+    void set_handles(const std::vector<Handle*>& handles) {
+        for (Vertex v = 0; v < static_cast<Vertex>(handles.size()); v++)
+            set_handle(v, handles[v]);
+    }
+
+    void mark_visited(Vertex v) { visited_stamp_[v] = epoch; }
+
+    // Vertices written during the current query, in first-touch order
+    const std::vector<Vertex>& touched() const { return touched_; }
+
+    Heap& heap() { return heap_; }
+    const Heap& heap() const { return heap_; }
+
+private:
+    Vertex num_vertices;
+    uint32_t epoch;
+
+    std::vector<Key> dist_;
+    std::vector<Vertex> parent_;
+    std::vector<Handle*> handles_;
+    std::vector<uint32_t> stamp_;         // epoch in which dist/parent/handle were written
+    std::vector<uint32_t> visited_stamp_; // epoch in which the vertex was settled
+    std::vector<Vertex> touched_;
+
+    Heap heap_;
+
+    void touch(Vertex v) {
+        if (stamp_[v] != epoch) {
+            stamp_[v] = epoch;
+            dist_[v] = infinite_weight<Key>();
+            parent_[v] = no_vertex<Vertex>();
+            handles_[v] = nullptr;
+            touched_.push_back(v);
+        }
+    }
+};
@@ -0,0 +1,285 @@
+#pragma once
+// Sequence Heap (Sanders, "Fast Priority Queues for Cached Memory")
+// Cache-efficient priority queue for very large queues. Elements flow through:
+//   insertion buffer (small binary heap)
+//     -> sorted runs in multi-level groups (k runs per group, merged upward)
+//     -> per-group buffers (k-way merge of the group's runs)
+//     -> deletion buffer (merge of the group buffers)
+// All bulk work is sequential merging of sorted arrays, so the cost per
+// operation stays roughly flat once the queue no longer fits in cache.
+// There are no handles and no decrease-key: it is meant for the
+// lazy-deletion pattern (push duplicates, skip stale entries on extraction).
+// Supports: insert, extract-min, find-min
+// Includes built-in metrics tracking for benchmarking
+// Templated on key and vertex-id types; SequenceHeap is the double/int default
+
+#include "trace.h"
+#include "latency_histogram.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstddef>
+
+template<typename KeyT = double, typename VertexT = int>
+class BasicSequenceHeap {
+public:
+    using Key = KeyT;
+    using Vertex = VertexT;
+
+    struct Entry {
+        Key key;
+        Vertex vertex;
+
+        bool operator<(const Entry& o) const { return key < o.key; }
+        bool operator>(const Entry& o) const { return key > o.key; }
+    };
+
+    // Metrics
+    int insert_count = 0;
+    int extract_min_count = 0;
+    int decrease_key_count = 0; // always 0; kept for the benchmark interface
+    double extract_min_time_ns = 0;
+    double decrease_key_time_ns = 0;
+    LatencyHistogram extract_min_latency; // per-operation latency distributions
+    LatencyHistogram decrease_key_latency;
+
+    // buffer_size: capacity of the insertion, group and deletion buffers
+    // merge_arity: number of sorted runs per group before it spills upward
+    explicit BasicSequenceHeap(std::size_t buffer_size = 256, std::size_t merge_arity = 64)
+        : m(buffer_size), k(merge_arity), n(0), del_head(0) {
+        insertion.reserve(m);
+    }
+
+    // Insert a vertex with given priority
+    void insert(Vertex vertex, Key priority) {
+        insert_count++;
+        if (insertion.size() == m)
+            flush_insertion_buffer();
+        insertion.push_back({priority, vertex});
+        std::push_heap(insertion.begin(), insertion.end(), std::greater<Entry>());
+        n++;
+    }
+
+    // Bulk-load (vertex, priority) pairs as a single sorted run. There are no
+    // handles to return; the sort is O(n log n) but is one sequential pass
+    // instead of n trips through the insertion buffer
+    void build(const std::vector<std::pair<Vertex, Key>>& items) {
+        insert_count += static_cast<int>(items.size());
+        if (items.empty()) return;
+
+        Run run;
+        run.data.reserve(items.size());
+        for (const auto& [vertex, priority] : items)
+            run.data.push_back({priority, vertex});
+        std::sort(run.data.begin(), run.data.end());
+
+        exchange_into(run.data, deletion, del_head);
+        insert_run(0, std::move(run));
+        n += items.size();
+    }
+
+    // Remove and return the minimum element as (vertex, priority)
+    std::pair<Vertex, Key> extract_min() {
+        auto start = std::chrono::high_resolution_clock::now();
+        extract_min_count++;
+
+        if (del_head == deletion.size())
+            refill_deletion_buffer();
+
+        Entry e;
+        if (!insertion.empty() &&
+            (del_head == deletion.size() || insertion.front().key < deletion[del_head].key)) {
+            std::pop_heap(insertion.begin(), insertion.end(), std::greater<Entry>());
+            e = insertion.back();
+            insertion.pop_back();
+        } else {
+            e = deletion[del_head++];
+        }
+        n--;
+
+        auto end = std::chrono::high_resolution_clock::now();
+        extract_min_time_ns += static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        trace::heap_op("extract_min", start, end);
+        extract_min_latency.record(start, end);
+
+        return {e.vertex, e.key};
+    }
+
+    bool empty() const { return n == 0; }
+    std::size_t size() const { return n; }
+
+    std::pair<Vertex, Key> find_min() {
+        if (del_head == deletion.size())
+            refill_deletion_buffer();
+        if (!insertion.empty() &&
+            (del_head == deletion.size() || insertion.front().key < deletion[del_head].key))
+            return {insertion.front().vertex, insertion.front().key};
+        return {deletion[del_head].vertex, deletion[del_head].key};
+    }
+
+    // Remove all elements; metrics are kept
+    void clear() {
+        insertion.clear();
+        groups.clear();
+        deletion.clear();
+        del_head = 0;
+        n = 0;
+    }
+
+    void reset_metrics() {
+        insert_count = 0;
+        extract_min_count = 0;
+        decrease_key_count = 0;
+        extract_min_time_ns = 0;
+        decrease_key_time_ns = 0;
+        extract_min_latency.clear();
+        decrease_key_latency.clear();
+    }
+
+    static const char* name() { return "SequenceHeap"; }
+
+private:
+    // Sorted run consumed from the front
+    struct Run {
+        std::vector<Entry> data;
+        std::size_t head = 0;
+
+        bool exhausted() const { return head == data.size(); }
+        const Entry& front() const { return data[head]; }
+    };
+
+    // Invariant: every element of buffer <= every element of runs
+    struct Group {
+        std::vector<Run> runs;
+        std::vector<Entry> buffer; // sorted, consumed from buffer_head
+        std::size_t buffer_head = 0;
+
+        bool buffer_empty() const { return buffer_head == buffer.size(); }
+    };
+
+    std::size_t m;
+    std::size_t k;
+    std::size_t n;
+
+    std::vector<Entry> insertion;  // min-heap ordered
+    std::vector<Group> groups;
+    std::vector<Entry> deletion;   // sorted, consumed from del_head
+    std::size_t del_head;
+
+    // Scratch space reused across merges
+    std::vector<std::pair<Key, std::size_t>> merge_heap;
+
+    // Sort the insertion buffer into a run and push it into group 0. New
+    // elements may be smaller than buffered ones, so they are first exchanged
+    // with the deletion buffer to keep it holding the smallest elements.
+    void flush_insertion_buffer() {
+        Run run;
+        run.data.swap(insertion);
+        insertion.reserve(m);
+        std::sort(run.data.begin(), run.data.end());
+
+        exchange_into(run.data, deletion, del_head);
+        insert_run(0, std::move(run));
+    }
+
+    // Merge a sorted run with a sorted buffer (from head): the buffer keeps its
+    // size but is refilled with the smallest elements; the rest stays in run
+    static void exchange_into(std::vector<Entry>& run, std::vector<Entry>& buffer,
+                              std::size_t& head) {
+        std::size_t keep = buffer.size() - head;
+        if (keep == 0 || run.empty() || !(run.front().key < buffer.back().key))
+            return;
+
+        std::vector<Entry> merged;
+        merged.reserve(keep + run.size());
+        std::merge(buffer.begin() + static_cast<std::ptrdiff_t>(head), buffer.end(),
+                   run.begin(), run.end(), std::back_inserter(merged));
+
+        buffer.assign(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(keep));
+        head = 0;
+        run.assign(merged.begin() + static_cast<std::ptrdiff_t>(keep), merged.end());
+    }
+
+    // Add a sorted run to group g, spilling a full group into the next level
+    void insert_run(std::size_t g, Run run) {
+        if (g == groups.size())
+            groups.emplace_back();
+
+        if (groups[g].runs.size() == k) {
+            Run spilled;
+            merge_runs(groups[g].runs, spilled.data, static_cast<std::size_t>(-1));
+            groups[g].runs.clear();
+            insert_run(g + 1, std::move(spilled));
+        }
+
+        Group& grp = groups[g];
+        exchange_into(run.data, grp.buffer, grp.buffer_head);
+        if (!run.data.empty())
+            grp.runs.push_back(std::move(run));
+    }
+
+    // k-way merge of up to limit elements from the runs into out (appended);
+    // exhausted runs are dropped
+    void merge_runs(std::vector<Run>& runs, std::vector<Entry>& out, std::size_t limit) {
+        merge_heap.clear();
+        for (std::size_t i = 0; i < runs.size(); i++)
+            if (!runs[i].exhausted())
+                merge_heap.push_back({runs[i].front().key, i});
+        std::make_heap(merge_heap.begin(), merge_heap.end(), std::greater<>());
+
+        std::size_t taken = 0;
+        while (!merge_heap.empty() && taken < limit) {
+            std::pop_heap(merge_heap.begin(), merge_heap.end(), std::greater<>());
+            std::size_t i = merge_heap.back().second;
+            merge_heap.pop_back();
+
+            Run& r = runs[i];
+            out.push_back(r.data[r.head++]);
+            taken++;
+            if (!r.exhausted()) {
+                merge_heap.push_back({r.front().key, i});
+                std::push_heap(merge_heap.begin(), merge_heap.end(), std::greater<>());
+            }
+        }
+
+        runs.erase(std::remove_if(runs.begin(), runs.end(),
+                                  [](const Run& r) { return r.exhausted(); }),
+                   runs.end());
+    }
+
+    void refill_group_buffer(Group& grp) {
+        grp.buffer.clear();
+        grp.buffer_head = 0;
+        merge_runs(grp.runs, grp.buffer, m);
+    }
+
+    // Fill the deletion buffer with the m smallest elements across all group
+    // buffers, refilling a group buffer from its runs whenever it drains
+    void refill_deletion_buffer() {
+        deletion.clear();
+        del_head = 0;
+
+        for (Group& grp : groups)
+            if (grp.buffer_empty() && !grp.runs.empty())
+                refill_group_buffer(grp);
+
+        while (deletion.size() < m) {
+            Group* best = nullptr;
+            for (Group& grp : groups) {
+                if (grp.buffer_empty()) continue;
+                if (!best || grp.buffer[grp.buffer_head].key < best->buffer[best->buffer_head].key)
+                    best = &grp;
+            }
+            if (!best) break;
+
+            deletion.push_back(best->buffer[best->buffer_head++]);
+            if (best->buffer_empty() && !best->runs.empty())
+                refill_group_buffer(*best);
+        }
+    }
+};
+
+using SequenceHeap = BasicSequenceHeap<>;
@@ -0,0 +1,194 @@
+#pragma once
+// Vectorized edge relaxation for high-degree vertices
+// For a block of u's edges the kernel computes base + weight, gathers the
+// current dist[to] and returns only the edges whose candidate is smaller
+// (compressed into (vertex, candidate) arrays). The search engine then
+// re-checks each candidate and calls decrease-key / insert as usual, so the
+// per-edge branch is replaced by one compare per 4 (AVX2) or 8 (AVX-512) edges.
+//   Dijkstra: base = dist[u], candidate = dist[u] + w
+//   Prim:     base = 0,       candidate = w
+// Kernels are compiled with target attributes and picked at runtime from the
+// CPU's features, so no global -mavx2 / -mavx512f flag is needed. Only the
+// default Graph layout (Edge = {int to; double weight}) is vectorized.
+
+#include "graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SIMD_RELAX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd_relax {
+
+enum class Kernel { Scalar, AVX2, AVX512 };
+
+// Vertices with fewer edges use the engine's scalar loop
+constexpr std::size_t min_degree = 16;
+// Edges per kernel call (bounds the candidate buffers on the stack)
+constexpr std::size_t block = 64;
+
+static_assert(sizeof(Edge) == 16 && offsetof(Edge, weight) == 8,
+              "kernels assume Edge = {int to; <pad>; double weight}");
+
+// Returns the number of candidates written to out_v / out_d (at most count)
+using KernelFn = std::size_t (*)(const Edge* edges, std::size_t count, double base,
+                                 const double* dist, int* out_v, double* out_d);
+
+inline std::size_t relax_scalar(const Edge* edges, std::size_t count, double base,
+                                const double* dist, int* out_v, double* out_d) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        double cand = base + edges[i].weight;
+        if (cand < dist[edges[i].to]) {
+            out_v[n] = edges[i].to;
+            out_d[n] = cand;
+            n++;
+        }
+    }
+    return n;
+}
+
+#ifdef SIMD_RELAX_X86
+
+// 4 edges per step: two 256-bit loads hold [to0 w0 to1 w1] [to2 w2 to3 w3]
+__attribute__((target("avx2")))
+inline std::size_t relax_avx2(const Edge* edges, std::size_t count, double base,
+                              const double* dist, int* out_v, double* out_d) {
+    const __m256d vbase = _mm256_set1_pd(base);
+    // Dword positions of to0..to3 after unpacklo: [to0 . to2 . to1 . to3 .]
+    const __m256i pick_ids = _mm256_setr_epi32(0, 4, 2, 6, 0, 0, 0, 0);
+    const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const double* p = reinterpret_cast<const double*>(edges + i);
+        __m256d a = _mm256_loadu_pd(p);
+        __m256d b = _mm256_loadu_pd(p + 4);
+        __m256d w = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8);
+        __m256i lo = _mm256_castpd_si256(_mm256_unpacklo_pd(a, b));
+        __m128i ids = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(lo, pick_ids));
+
+        __m256d cand = _mm256_add_pd(vbase, w);
+        __m256d cur = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), dist, ids, all_lanes, 8);
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_pd(_mm256_cmp_pd(cand, cur, _CMP_LT_OQ)));
+        if (mask) {
+            alignas(32) double c[4];
+            _mm256_store_pd(c, cand);
+            while (mask) {
+                unsigned j = static_cast<unsigned>(__builtin_ctz(mask));
+                mask &= mask - 1;
+                out_v[n] = edges[i + j].to;
+                out_d[n] = c[j];
+                n++;
+            }
+        }
+    }
+    return n + relax_scalar(edges + i, count - i, base, dist, out_v + n, out_d + n);
+}
+
+// 8 edges per step; the target ids are widened to 64-bit lanes (padding
+// masked off) and candidates are written with compress-stores
+__attribute__((target("avx512f")))
+inline std::size_t relax_avx512(const Edge* edges, std::size_t count, double base,
+                                const double* dist, int* out_v, double* out_d) {
+    const __m512d vbase = _mm512_set1_pd(base);
+    const __m512i pick_w = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+    const __m512i pick_ids = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m512i low_dword = _mm512_set1_epi64(0xFFFFFFFF);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const double* p = reinterpret_cast<const double*>(edges + i);
+        __m512d a = _mm512_loadu_pd(p);
+        __m512d b = _mm512_loadu_pd(p + 8);
+        __m512d w = _mm512_permutex2var_pd(a, pick_w, b);
+        __m512i ids = _mm512_and_si512(
+            _mm512_permutex2var_epi64(_mm512_castpd_si512(a), pick_ids, _mm512_castpd_si512(b)),
+            low_dword);
+
+        __m512d cand = _mm512_add_pd(vbase, w);
+        __m512d cur = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, ids, dist, 8);
+        __mmask8 mask = _mm512_cmp_pd_mask(cand, cur, _CMP_LT_OQ);
+        if (mask) {
+            unsigned found = static_cast<unsigned>(__builtin_popcount(mask));
+            _mm512_mask_cvtepi64_storeu_epi32(out_v + n, static_cast<__mmask8>((1u << found) - 1),
+                                              _mm512_maskz_compress_epi64(mask, ids));
+            _mm512_mask_compressstoreu_pd(out_d + n, mask, cand);
+            n += found;
+        }
+    }
+    return n + relax_scalar(edges + i, count - i, base, dist, out_v + n, out_d + n);
+}
+
+#endif // SIMD_RELAX_X86
+
+inline bool supported(Kernel k) {
+    switch (k) {
+    case Kernel::Scalar: return true;
+#ifdef SIMD_RELAX_X86
+    case Kernel::AVX2: return __builtin_cpu_supports("avx2");
+    case Kernel::AVX512: return __builtin_cpu_supports("avx512f");
+#endif
+    default: return false;
+    }
+}
+
+inline Kernel best_supported() {
+    if (supported(Kernel::AVX512)) return Kernel::AVX512;
+    if (supported(Kernel::AVX2)) return Kernel::AVX2;
+    return Kernel::Scalar;
+}
+
+inline const char* name(Kernel k) {
+    switch (k) {
+    case Kernel::AVX2: return "AVX2";
+    case Kernel::AVX512: return "AVX-512";
+    default: return "Scalar";
+    }
+}
+
+// Kernel used by the search engine; the best supported one unless overridden.
+// Scalar disables the block path entirely (plain per-edge loop).
+inline Kernel& active_kernel() {
+    static Kernel k = best_supported();
+    return k;
+}
+
+// Select a kernel (benchmarks); returns false and leaves the setting unchanged
+// if the CPU doesn't support it
+inline bool set_kernel(Kernel k) {
+    if (!supported(k)) return false;
+    active_kernel() = k;
+    return true;
+}
+
+inline KernelFn kernel_fn(Kernel k) {
+#ifdef SIMD_RELAX_X86
+    if (k == Kernel::AVX512) return relax_avx512;
+    if (k == Kernel::AVX2) return relax_avx2;
+#endif
+    (void)k;
+    return relax_scalar;
+}
+
+// Labels that expose a contiguous dist array (DenseLabels) over contiguous
+// edges in the default Edge layout can use the kernels; others (e.g.
+// SearchWorkspace, or a CompressedGraph decoding on the fly) can't
+template<typename G, typename Labels, typename = void>
+struct eligible : std::false_type {};
+
+template<typename G, typename Labels>
+struct eligible<G, Labels, std::void_t<decltype(std::declval<const Labels&>().dist_data()),
+                                       decltype(std::declval<const G&>().adj[0].data())>>
+    : std::bool_constant<std::is_same<typename G::Edge, Edge>::value &&
+                         std::is_same<decltype(std::declval<const G&>().adj[0].data()),
+                                      const Edge*>::value &&
+                         std::is_same<decltype(std::declval<const Labels&>().dist_data()),
+                                      const double*>::value> {};
+
+} // namespace simd_relax
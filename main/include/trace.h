@@ -0,0 +1,270 @@
+#pragma once
+// Timeline tracing in Chrome trace-event format (open in Perfetto or chrome://tracing)
+// Off by default; while off every hook is one relaxed atomic load. Once
+// enable() is called, each thread appends events to its own ring buffer (no
+// locks on the hot path; the oldest events are overwritten when it is full):
+//   Zone zone("name", "category") - scoped span, recorded when it closes
+//   complete(name, cat, start, end) - span from two existing time points
+//   heap_op(name, start, end)       - one in every sample_every heap
+//                                     operations, from the heaps' own timing
+// write_chrome_json(path) merges all threads' buffers into one JSON file with
+// a track per thread. Call enable / clear / write from the driver while no
+// traced work runs; buffers of finished threads are kept until clear().
+// Names must outlive the trace: string literals, or intern() for built names.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace trace {
+
+using clock = std::chrono::high_resolution_clock; // the clock the heaps time with
+
+struct Event {
+    const char* name;
+    const char* category;
+    std::int64_t start_ns; // since the trace epoch
+    std::int64_t dur_ns;
+};
+
+// One thread's events; grows to capacity, then wraps around
+struct ThreadBuffer {
+    int tid = 0;
+    std::string thread_name;
+    std::vector<Event> events;
+    std::size_t capacity = 0;
+    std::size_t next = 0;      // slot for the next event once wrapped
+    std::uint64_t written = 0; // events ever recorded (written - size = overwritten)
+    std::uint64_t op_tick = 0; // heap_op sampling counter
+
+    void push(const Event& e) {
+        if (events.size() < capacity) {
+            events.push_back(e);
+        } else if (capacity) {
+            events[next] = e;
+            next = (next + 1) % capacity;
+        }
+        written++;
+    }
+};
+
+struct Summary {
+    int threads = 0;
+    std::size_t events = 0;     // events in the buffers
+    std::uint64_t overwritten = 0;
+};
+
+namespace detail {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::set<std::string> names; // interned strings (node addresses are stable)
+    int next_tid = 1;
+    std::size_t capacity = std::size_t(1) << 16;
+    clock::time_point epoch = clock::now();
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+inline std::atomic<bool>& enabled_flag() {
+    static std::atomic<bool> on{false};
+    return on;
+}
+
+inline std::atomic<unsigned>& sample_period() {
+    static std::atomic<unsigned> every{64};
+    return every;
+}
+
+inline ThreadBuffer& local() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto b = std::make_shared<ThreadBuffer>();
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        b->tid = r.next_tid++;
+        b->thread_name = b->tid == 1 ? "main" : "thread " + std::to_string(b->tid);
+        b->capacity = r.capacity;
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+inline std::int64_t since_epoch(clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t - registry().epoch).count();
+}
+
+inline void write_string(std::ostream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out << '\\' << *s;
+        else if (static_cast<unsigned char>(*s) < 0x20) out << ' ';
+        else out << *s;
+    }
+    out << '"';
+}
+
+inline void write_us(std::ostream& out, std::int64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(ns) / 1e3);
+    out << buf;
+}
+
+} // namespace detail
+
+inline bool enabled() { return detail::enabled_flag().load(std::memory_order_relaxed); }
+
+// Start a fresh recording: events_per_thread bounds each ring buffer,
+// sample_every thins heap operations (1 = every operation)
+inline void enable(std::size_t events_per_thread = std::size_t(1) << 16, unsigned sample_every = 64) {
+    detail::Registry& r = detail::registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.capacity = events_per_thread;
+        for (auto& b : r.buffers) {
+            b->events.clear();
+            b->next = 0;
+            b->written = 0;
+            b->capacity = events_per_thread;
+        }
+    }
+    detail::sample_period().store(std::max(sample_every, 1u), std::memory_order_relaxed);
+    detail::enabled_flag().store(true, std::memory_order_relaxed);
+}
+
+inline void disable() { detail::enabled_flag().store(false, std::memory_order_relaxed); }
+
+// Drop recorded events, and the buffers of threads that have exited
+inline void clear() {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.buffers.erase(std::remove_if(r.buffers.begin(), r.buffers.end(),
+                                   [](const std::shared_ptr<ThreadBuffer>& b) { return b.use_count() == 1; }),
+                    r.buffers.end());
+    for (auto& b : r.buffers) {
+        b->events.clear();
+        b->next = 0;
+        b->written = 0;
+    }
+}
+
+// Stable copy of a built string, for zone names
+inline const char* intern(const std::string& s) {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.names.insert(s).first->c_str();
+}
+
+// Label for the calling thread's track
+inline void set_thread_name(const std::string& name) {
+    if (!enabled()) return;
+    ThreadBuffer& b = detail::local();
+    std::lock_guard<std::mutex> lock(detail::registry().mutex);
+    b.thread_name = name;
+}
+
+inline void complete(const char* name, const char* category, clock::time_point start, clock::time_point end) {
+    if (!enabled()) return;
+    std::int64_t s = detail::since_epoch(start);
+    detail::local().push({name, category, s, detail::since_epoch(end) - s});
+}
+
+// Sampled heap operation; called next to each heap's own op timing
+inline void heap_op(const char* name, clock::time_point start, clock::time_point end) {
+    if (!enabled()) return;
+    ThreadBuffer& b = detail::local();
+    if (++b.op_tick % detail::sample_period().load(std::memory_order_relaxed) != 0) return;
+    std::int64_t s = detail::since_epoch(start);
+    b.push({name, "heap", s, detail::since_epoch(end) - s});
+}
+
+class Zone {
+public:
+    Zone(const char* name, const char* category) : name(name), category(category) {
+        if (enabled()) start = clock::now();
+    }
+    // Built names are interned only while tracing is on
+    Zone(const std::string& name, const char* category)
+        : Zone(enabled() ? intern(name) : "", category) {}
+
+    ~Zone() {
+        if (start != clock::time_point()) complete(name, category, start, clock::now());
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    clock::time_point start{};
+};
+
+inline Summary summary() {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Summary s;
+    for (const auto& b : r.buffers) {
+        if (b->written == 0) continue;
+        s.threads++;
+        s.events += b->events.size();
+        s.overwritten += b->written - b->events.size();
+    }
+    return s;
+}
+
+// Chrome trace-event JSON ("X" complete events, microsecond timestamps);
+// false if the file can't be written
+inline bool write_chrome_json(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto sep = [&] {
+        if (!first) out << ",\n";
+        first = false;
+    };
+    for (const auto& b : r.buffers) {
+        if (b->written == 0) continue;
+        sep();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid << ",\"args\":{\"name\":";
+        detail::write_string(out, b->thread_name.c_str());
+        out << "}}";
+        // Oldest first: once wrapped, the oldest event is at `next`
+        std::size_t n = b->events.size();
+        std::size_t begin = n == b->capacity ? b->next : 0;
+        for (std::size_t i = 0; i < n; i++) {
+            const Event& e = b->events[(begin + i) % n];
+            sep();
+            out << "{\"name\":";
+            detail::write_string(out, e.name);
+            out << ",\"cat\":";
+            detail::write_string(out, e.category);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid << ",\"ts\":";
+            detail::write_us(out, e.start_ns);
+            out << ",\"dur\":";
+            detail::write_us(out, e.dur_ns);
+            out << "}";
+        }
+    }
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace trace
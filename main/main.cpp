@@ -9,28 +9,1578 @@
 
 #include "include/benchmark.h"
 #include "include/graph_generator.h"
+#include "include/policy_pairing_heap.h"
+#include "include/rank_pairing_heap.h"
+#include "include/hollow_heap.h"
+#include "include/sequence_heap.h"
+#include "include/algorithms.h"
+#include "include/reorder.h"
+#include "include/perf_counters.h"
+#include "include/parallel_sssp.h"
+#include "include/bench_executor.h"
+#include "include/dynamic_sssp.h"
+#include "include/query_service.h"
+#include "include/bounded_search.h"
+#include "include/csr_graph.h"
+#include "include/compressed_graph.h"
+#include "include/heap_workload.h"
+#include "include/complexity_fit.h"
+#include "include/trace.h"
 #include <iostream>
+#include <iomanip>
 #include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <deque>
+#include <sstream>
 
-void run_experiment(const Graph& g, const std::string& graph_type) {
-    std::cout << "\n=== " << graph_type
-              << " (V=" << g.size()
+void add_experiment(BenchmarkExecutor& exec, const Graph& g, const std::string& graph_type) {
+    // Dijkstra with all five heaps
+    exec.add([&g, graph_type] { return Benchmark::run_dijkstra<BinaryHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_dijkstra<FibonacciHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_dijkstra<PairingHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_dijkstra<RankPairingHeap2>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_dijkstra<HollowHeapMultiRoot>(g, graph_type); });
+
+    // Prim with all five heaps
+    exec.add([&g, graph_type] { return Benchmark::run_prim<BinaryHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_prim<FibonacciHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_prim<PairingHeap>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_prim<RankPairingHeap2>(g, graph_type); });
+    exec.add([&g, graph_type] { return Benchmark::run_prim<HollowHeapMultiRoot>(g, graph_type); });
+
+    // Above the density threshold the heap-free O(V^2) scans are added automatically
+    if (is_dense(g)) {
+        exec.add([&g, graph_type] { return Benchmark::run_dijkstra<DenseArrayQueue>(g, graph_type); });
+        exec.add([&g, graph_type] { return Benchmark::run_dijkstra_matrix(g, graph_type); });
+        exec.add([&g, graph_type] { return Benchmark::run_prim<DenseArrayQueue>(g, graph_type); });
+        exec.add([&g, graph_type] { return Benchmark::run_prim_matrix(g, graph_type); });
+    }
+}
+
+// Pairing heap merge strategies vs the original PairingHeap on worst-case graphs
+void run_pairing_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Pairing Heap Variants on Worst-Case Graphs\n";
+    std::cout << "============================================================\n";
+
+    std::vector<int> sizes = {10000, 100000, 1000000};
+
+    for (int n : sizes) {
+        auto g = GraphGenerator::worst_case_graph(n);
+        std::cout << "\n=== WorstCase (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+
+        Benchmark::print_header();
+
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapMultipass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapAuxTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapBackToFront>(g, "WorstCase"));
+
+        Benchmark::print_result(Benchmark::run_prim<PairingHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapMultipass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapAuxTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapBackToFront>(g, "WorstCase"));
+    }
+
+    Benchmark::verify_results();
+}
+
+// Rank-pairing heaps (both rank rules) vs the baseline heaps on worst-case
+// graphs, the setting where an O(1) decrease-key heap has the best chance
+void run_rank_pairing_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Rank-Pairing Heaps on Worst-Case Graphs\n";
+    std::cout << "============================================================\n";
+
+    std::vector<int> sizes = {10000, 100000, 1000000};
+
+    for (int n : sizes) {
+        auto g = GraphGenerator::worst_case_graph(n);
+        std::cout << "\n=== WorstCase (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+
+        Benchmark::print_header();
+
+        Benchmark::print_result(Benchmark::run_dijkstra<BinaryHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<FibonacciHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<RankPairingHeap1>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_dijkstra<RankPairingHeap2>(g, "WorstCase"));
+
+        Benchmark::print_result(Benchmark::run_prim<BinaryHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<FibonacciHeap>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapTwoPass>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<RankPairingHeap1>(g, "WorstCase"));
+        Benchmark::print_result(Benchmark::run_prim<RankPairingHeap2>(g, "WorstCase"));
+    }
+
+    Benchmark::verify_results();
+}
+
+// Hollow heaps (single- and multi-root) vs Fibonacci heap for Prim on dense
+// graphs, where decrease-key counts are highest relative to extract-min
+void run_hollow_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Hollow Heaps vs Fibonacci Heap (Prim, Dense Graphs)\n";
+    std::cout << "============================================================\n";
+
+    std::vector<int> sizes = {1000, 2000, 4000};
+
+    for (int n : sizes) {
+        auto g = GraphGenerator::dense_random(n);
+        std::cout << "\n=== Dense (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+
+        Benchmark::print_header();
+
+        Benchmark::print_result(Benchmark::run_prim<FibonacciHeap>(g, "Dense"));
+        Benchmark::print_result(Benchmark::run_prim<HollowHeapSingleRoot>(g, "Dense"));
+        Benchmark::print_result(Benchmark::run_prim<HollowHeapMultiRoot>(g, "Dense"));
+    }
+
+    Benchmark::verify_results();
+}
+
+// Queue-size sweep (hold model) for the sequence heap vs the array and pointer
+// heaps, from 10^3 entries up to max_size. The handle-based heaps allocate a
+// node per entry, so they are only run up to 10^7 entries.
+void run_sequence_heap_sweep(double max_size) {
+    std::cout << "============================================================\n";
+    std::cout << "  Sequence Heap: Queue-Size Sweep (ns per extract+insert)\n";
+    std::cout << "============================================================\n\n";
+
+    const double baseline_limit = 1e7;
+
+    std::cout << std::left << std::setw(12) << "Entries"
+              << std::setw(16) << "SequenceHeap"
+              << std::setw(16) << "BinaryHeap"
+              << std::setw(16) << "Pairing2Pass" << "\n";
+    std::cout << std::string(60, '-') << "\n";
+
+    for (double size = 1e3; size <= max_size; size *= 10) {
+        int n = static_cast<int>(size);
+        std::cout << std::left << std::setw(12) << n << std::fixed << std::setprecision(1)
+                  << std::setw(16) << Benchmark::time_hold_ops<SequenceHeap>(n) << std::flush;
+        if (size <= baseline_limit) {
+            std::cout << std::setw(16) << Benchmark::time_hold_ops<BinaryHeap>(n) << std::flush;
+            std::cout << std::setw(16) << Benchmark::time_hold_ops<PairingHeapTwoPass>(n);
+        } else {
+            std::cout << std::setw(16) << "-" << std::setw(16) << "-";
+        }
+        std::cout << "\n";
+    }
+
+    // Lazy-deletion Dijkstra on a large grid against the decrease-key heaps
+    int side = 1000;
+    auto g = GraphGenerator::grid_graph(side, side);
+    std::cout << "\n=== Grid (V=" << g.size()
               << ", E=" << g.edge_count() << ") ===\n\n";
 
     Benchmark::print_header();
+    Benchmark::print_result(Benchmark::run_dijkstra_lazy<SequenceHeap>(g, "Grid"));
+    Benchmark::print_result(Benchmark::run_dijkstra<BinaryHeap>(g, "Grid"));
+    Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapTwoPass>(g, "Grid"));
+
+    Benchmark::verify_results();
+}
+
+// Eager (all vertices inserted with INF up front) vs lazy (insert on first
+// discovery) heap population; the Peak column shows the largest heap size
+void run_lazy_insert_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Eager vs Lazy Vertex Insertion\n";
+    std::cout << "============================================================\n";
+
+    // random_graph generation is O(V^2), which bounds the size used here
+    const int n = 20000;
+    int side = static_cast<int>(std::sqrt(static_cast<double>(n)));
+
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Sparse", GraphGenerator::sparse_random(n));
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(side, side));
+    graphs.emplace_back("WorstCase", GraphGenerator::worst_case_graph(n));
+
+    for (const auto& [graph_type, g] : graphs) {
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+
+        Benchmark::print_header();
+
+        for (InsertMode mode : {InsertMode::Eager, InsertMode::Lazy}) {
+            Benchmark::print_result(Benchmark::run_dijkstra<BinaryHeap>(g, graph_type, mode));
+            Benchmark::print_result(Benchmark::run_dijkstra<FibonacciHeap>(g, graph_type, mode));
+            Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapTwoPass>(g, graph_type, mode));
+        }
+        for (InsertMode mode : {InsertMode::Eager, InsertMode::Lazy}) {
+            Benchmark::print_result(Benchmark::run_prim<BinaryHeap>(g, graph_type, mode));
+            Benchmark::print_result(Benchmark::run_prim<FibonacciHeap>(g, graph_type, mode));
+            Benchmark::print_result(Benchmark::run_prim<PairingHeapTwoPass>(g, graph_type, mode));
+        }
+    }
+
+    Benchmark::verify_results();
+}
+
+// Average latency of repeated Dijkstra queries: a fresh allocation per query
+// (dijkstra<Heap>, lazy insertion) vs a reused SearchWorkspace
+template<typename Heap>
+void time_repeated_queries(const Graph& g, const std::vector<int>& sources) {
+    using clock = std::chrono::high_resolution_clock;
+    using Key = typename Heap::Key;
+    // Every vertex's distance, unreached ones as -1, so any label that differs
+    // between the two paths changes the checksum; summed outside the timing
+    auto distance_sum = [&](auto dist) {
+        double sum = 0;
+        for (int v = 0; v < g.size(); v++) {
+            Key d = dist(v);
+            sum += d == infinite_weight<Key>() ? -1.0 : static_cast<double>(d);
+        }
+        return sum;
+    };
+    double checksum_fresh = 0, checksum_ws = 0;
+    clock::duration fresh_time{}, ws_time{};
+
+    for (int s : sources) {
+        auto start = clock::now();
+        auto r = dijkstra<Heap>(g, s, InsertMode::Lazy);
+        fresh_time += clock::now() - start;
+        checksum_fresh += distance_sum([&](int v) { return r.dist[v]; });
+    }
+
+    SearchWorkspace<Heap> ws(g.size());
+    for (int s : sources) {
+        auto start = clock::now();
+        dijkstra(g, s, ws);
+        ws_time += clock::now() - start;
+        checksum_ws += distance_sum([&](int v) { return ws.dist(v); });
+    }
+
+    double fresh_us = std::chrono::duration<double, std::micro>(fresh_time).count() / sources.size();
+    double ws_us = std::chrono::duration<double, std::micro>(ws_time).count() / sources.size();
+    std::cout << std::left << std::setw(16) << Heap::name()
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << fresh_us
+              << std::setw(14) << ws_us
+              << (std::fabs(checksum_fresh - checksum_ws) <= 1e-9 * std::fabs(checksum_fresh) ? "ok" : "MISMATCH")
+              << "\n";
+}
+
+void run_workspace_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Repeated Queries: Fresh Allocation vs SearchWorkspace\n";
+    std::cout << "============================================================\n";
 
-    // Dijkstra with all three heaps
-    Benchmark::print_result(Benchmark::run_dijkstra<BinaryHeap>(g, graph_type));
-    Benchmark::print_result(Benchmark::run_dijkstra<FibonacciHeap>(g, graph_type));
-    Benchmark::print_result(Benchmark::run_dijkstra<PairingHeap>(g, graph_type));
+    std::mt19937 rng(7);
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(300, 300));
+    graphs.emplace_back("Sparse", GraphGenerator::sparse_random(20000));
 
-    // Prim with all three heaps
-    Benchmark::print_result(Benchmark::run_prim<BinaryHeap>(g, graph_type));
-    Benchmark::print_result(Benchmark::run_prim<FibonacciHeap>(g, graph_type));
-    Benchmark::print_result(Benchmark::run_prim<PairingHeap>(g, graph_type));
+    for (const auto& [graph_type, g] : graphs) {
+        std::uniform_int_distribution<int> pick(0, g.size() - 1);
+        std::vector<int> sources(200);
+        for (int& s : sources) s = pick(rng);
+
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << "), " << sources.size() << " queries ===\n\n";
+        std::cout << std::left << std::setw(16) << "Heap"
+                  << std::setw(14) << "Fresh(us)"
+                  << std::setw(14) << "Reused(us)" << "Check\n";
+        std::cout << std::string(50, '-') << "\n";
+
+        time_repeated_queries<BinaryHeap>(g, sources);
+        time_repeated_queries<FibonacciHeap>(g, sources);
+        time_repeated_queries<PairingHeapTwoPass>(g, sources);
+    }
+}
+
+// One row of the key / id type comparison: convert the base graph, then run
+// Dijkstra with a binary and a pairing heap instantiated on the same types
+template<typename Weight, typename Vertex>
+void run_key_type_row(const Graph& base, const char* weight_name, const char* vertex_name) {
+    using G = BasicGraph<Weight, Vertex>;
+    using Binary = BasicBinaryHeap<Weight, Vertex>;
+    using Pairing = PolicyPairingHeap<pairing_merge::TwoPass, Weight, Vertex>;
+
+    G g = convert_graph<G>(base);
+    double graph_mb = g.memory_bytes() / (1024.0 * 1024.0);
+
+    auto row = [&](const char* heap_name, std::size_t node_bytes, const BenchmarkResult& r) {
+        std::cout << std::left << std::setw(10) << weight_name
+                  << std::setw(10) << vertex_name
+                  << std::setw(9) << sizeof(typename G::Edge)
+                  << std::setw(11) << std::fixed << std::setprecision(1) << graph_mb
+                  << std::setw(14) << heap_name
+                  << std::setw(9) << node_bytes
+                  << std::setw(12) << std::setprecision(3) << r.total_time_ms
+                  << std::setprecision(1) << r.result_value << "\n";
+    };
+    row("BinaryHeap", sizeof(typename Binary::Node),
+        Benchmark::run_dijkstra<Binary>(g, "Grid", InsertMode::Lazy));
+    row("Pairing2Pass", sizeof(typename Pairing::Node),
+        Benchmark::run_dijkstra<Pairing>(g, "Grid", InsertMode::Lazy));
+}
+
+// Memory and speed per key / vertex-id combination on one grid graph. Integer
+// weights are rounded, so their distance sums differ slightly from float/double.
+void run_key_type_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Key and Vertex-Id Types: Memory and Speed\n";
+    std::cout << "============================================================\n";
+
+    Graph base = GraphGenerator::grid_graph(700, 700);
+    std::cout << "\n=== Grid (V=" << base.size() << ", E=" << base.edge_count()
+              << "), Dijkstra, lazy insertion ===\n\n";
+    std::cout << std::left << std::setw(10) << "Key"
+              << std::setw(10) << "Vertex"
+              << std::setw(9) << "Edge(B)"
+              << std::setw(11) << "Graph(MB)"
+              << std::setw(14) << "Heap"
+              << std::setw(9) << "Node(B)"
+              << std::setw(12) << "Time(ms)"
+              << "DistSum\n";
+    std::cout << std::string(90, '-') << "\n";
+
+    run_key_type_row<double, int>(base, "double", "int32");
+    run_key_type_row<float, int>(base, "float", "int32");
+    run_key_type_row<float, uint32_t>(base, "float", "uint32");
+    run_key_type_row<uint32_t, int>(base, "uint32", "int32");
+    run_key_type_row<uint64_t, int>(base, "uint64", "int32");
+    run_key_type_row<double, int64_t>(base, "double", "int64");
+}
+
+struct ReorderRun {
+    double time_ms;        // best of 3 runs
+    std::uint64_t misses;  // cache misses in the best run (0 if no counter)
+    bool ok;               // distances mapped back match the original graph's
+};
+
+// Dijkstra (lazy insertion) on a permuted graph from the image of vertex 0
+template<typename Heap>
+ReorderRun run_reordered_dijkstra(const Graph& pg, const VertexOrder& order,
+                                  const std::vector<double>& reference) {
+    ReorderRun run{std::numeric_limits<double>::infinity(), 0, true};
+    CacheMissCounter counter;
+    for (int rep = 0; rep < 3; rep++) {
+        counter.start();
+        auto start = std::chrono::high_resolution_clock::now();
+        auto result = dijkstra<Heap>(pg, order.new_id[0], InsertMode::Lazy);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::uint64_t misses = counter.stop();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (ms < run.time_ms) {
+            run.time_ms = ms;
+            run.misses = misses;
+        }
+        // Equal-length paths may be summed in a different order, so allow rounding
+        std::vector<double> dist = map_back(result.dist, order);
+        for (std::size_t v = 0; v < dist.size(); v++)
+            if (std::fabs(dist[v] - reference[v]) > 1e-9 * std::max(1.0, reference[v]))
+                run.ok = false;
+    }
+    return run;
+}
+
+// Runtime and cache misses of Dijkstra under each vertex numbering. "Shuffled"
+// is a random relabelling, standing in for a graph loaded with arbitrary ids.
+void run_reorder_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Vertex Reordering: Locality vs Runtime\n";
+    std::cout << "============================================================\n";
+
+    const int grid_side = 1000;
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Sparse", GraphGenerator::sparse_random(20000));
+    graphs.emplace_back("Dense", GraphGenerator::dense_random(2000));
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(grid_side, grid_side));
+    graphs.emplace_back("WorstCase", GraphGenerator::worst_case_graph(200000));
+
+    bool have_counter = CacheMissCounter().available();
+    if (!have_counter)
+        std::cout << "\n(hardware cache-miss counter unavailable; Misses column shows n/a)\n";
+
+    for (const auto& [graph_type, g] : graphs) {
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << "), Dijkstra, lazy insertion ===\n\n";
+        std::cout << std::left << std::setw(12) << "Order"
+                  << std::setw(13) << "Reorder(ms)"
+                  << std::setw(13) << "Binary(ms)"
+                  << std::setw(14) << "Misses"
+                  << std::setw(13) << "Pairing(ms)"
+                  << std::setw(14) << "Misses"
+                  << "Check\n";
+        std::cout << std::string(85, '-') << "\n";
+
+        std::vector<double> reference = dijkstra<BinaryHeap>(g, 0, InsertMode::Lazy).dist;
+
+        std::vector<std::pair<std::string, std::function<VertexOrder()>>> orders;
+        orders.emplace_back("Original", [&] { return identity_order(g); });
+        orders.emplace_back("Shuffled", [&] { return shuffled_order(g); });
+        orders.emplace_back("BFS", [&] { return bfs_order(g); });
+        orders.emplace_back("RCM", [&] { return cuthill_mckee_order(g); });
+        orders.emplace_back("Degree", [&] { return degree_order(g); });
+        if (graph_type == "Grid")
+            orders.emplace_back("Hilbert", [&] { return hilbert_order(grid_side, grid_side); });
+
+        for (const auto& [order_name, make_order] : orders) {
+            auto start = std::chrono::high_resolution_clock::now();
+            VertexOrder order = make_order();
+            Graph pg = permute_graph(g, order);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            ReorderRun binary = run_reordered_dijkstra<BinaryHeap>(pg, order, reference);
+            ReorderRun pairing = run_reordered_dijkstra<PairingHeapTwoPass>(pg, order, reference);
+
+            auto misses = [&](const ReorderRun& r) {
+                return have_counter ? std::to_string(r.misses) : std::string("n/a");
+            };
+            std::cout << std::left << std::setw(12) << order_name
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(13) << std::chrono::duration<double, std::milli>(end - start).count()
+                      << std::setw(13) << binary.time_ms
+                      << std::setw(14) << misses(binary)
+                      << std::setw(13) << pairing.time_ms
+                      << std::setw(14) << misses(pairing)
+                      << (binary.ok && pairing.ok ? "ok" : "MISMATCH") << "\n";
+        }
+    }
+}
+
+// Best-of-3 wall time of one search; the result value is stored for checking
+template<typename Fn>
+double best_of_3_ms(Fn&& run, double& value) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int rep = 0; rep < 3; rep++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        value = run();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Scalar vs vectorized edge relaxation (simd_relax.h) on graphs whose vertices
+// have hundreds or thousands of edges; kernels the CPU lacks are skipped
+void run_simd_relax_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Edge Relaxation: Scalar vs SIMD Kernels\n";
+    std::cout << "============================================================\n";
+
+    std::vector<simd_relax::Kernel> kernels;
+    for (auto k : {simd_relax::Kernel::Scalar, simd_relax::Kernel::AVX2, simd_relax::Kernel::AVX512})
+        if (simd_relax::supported(k)) kernels.push_back(k);
+    simd_relax::Kernel default_kernel = simd_relax::active_kernel();
+
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Dense", GraphGenerator::dense_random(2000));
+    graphs.emplace_back("Dense", GraphGenerator::dense_random(4000));
+    graphs.emplace_back("Complete", GraphGenerator::complete_graph(3000));
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(500, 500));
+
+    for (const auto& [graph_type, g] : graphs) {
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+        std::cout << std::left << std::setw(20) << "Run"
+                  << std::setw(10) << "Kernel"
+                  << std::setw(12) << "Time(ms)"
+                  << std::setw(10) << "Speedup"
+                  << "Check\n";
+        std::cout << std::string(58, '-') << "\n";
+
+        // Dijkstra runs move their whole dist array into labels (compared with
+        // the scalar kernel's element by element, outside the timing); Prim
+        // is checked by its total tree weight
+        std::vector<double> labels;
+        std::vector<std::pair<std::string, std::function<double()>>> runs;
+        runs.emplace_back("Dijkstra eager", [&] {
+            labels = dijkstra<BinaryHeap>(g, 0).dist;
+            return 0.0;
+        });
+        runs.emplace_back("Dijkstra lazy", [&] {
+            labels = dijkstra<BinaryHeap>(g, 0, InsertMode::Lazy).dist;
+            return 0.0;
+        });
+        runs.emplace_back("Prim eager", [&] {
+            labels.clear();
+            return prim<BinaryHeap>(g).total_weight;
+        });
+
+        for (const auto& [run_name, run] : runs) {
+            double scalar_ms = 0, scalar_value = 0;
+            std::vector<double> scalar_labels;
+            for (auto k : kernels) {
+                simd_relax::set_kernel(k);
+                double value = 0;
+                double ms = best_of_3_ms(run, value);
+                if (k == simd_relax::Kernel::Scalar) {
+                    scalar_ms = ms;
+                    scalar_value = value;
+                    scalar_labels = labels;
+                }
+                bool ok = std::fabs(value - scalar_value) < 1e-6 && labels == scalar_labels;
+                std::cout << std::left << std::setw(20) << run_name
+                          << std::setw(10) << simd_relax::name(k)
+                          << std::fixed << std::setprecision(3)
+                          << std::setw(12) << ms
+                          << std::setprecision(2) << std::setw(10) << scalar_ms / ms
+                          << (ok ? "ok" : "MISMATCH") << "\n";
+            }
+        }
+    }
+    simd_relax::set_kernel(default_kernel);
+}
+
+// Heap-based vs heap-free O(V^2) searches (dense_search.h) across edge
+// densities, to locate the crossover behind dense_density_threshold
+void run_dense_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Dense Graphs: Heaps vs O(V^2) Array / Matrix Scans\n";
+    std::cout << "  (density threshold " << dense_density_threshold
+              << ", argmin kernel " << simd_relax::name(simd_relax::active_kernel()) << ")\n";
+    std::cout << "============================================================\n";
+
+    const int n = 3000;
+    for (double p : {0.01, 0.05, 0.1, 0.25, 0.5, 1.0}) {
+        auto g = p < 1.0 ? GraphGenerator::random_graph(n, p) : GraphGenerator::complete_graph(n);
+        std::string graph_type = "p=" + std::to_string(p).substr(0, 4);
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << ", density "
+                  << std::fixed << std::setprecision(3) << graph_density(g)
+                  << (is_dense(g) ? ", dense" : "") << ") ===\n\n";
+
+        Benchmark::print_header();
+        Benchmark::print_result(Benchmark::run_dijkstra<BinaryHeap>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_dijkstra<PairingHeapTwoPass>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_dijkstra<DenseArrayQueue>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_dijkstra_matrix(g, graph_type));
+        Benchmark::print_result(Benchmark::run_prim<BinaryHeap>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_prim<PairingHeapTwoPass>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_prim<DenseArrayQueue>(g, graph_type));
+        Benchmark::print_result(Benchmark::run_prim_matrix(g, graph_type));
+    }
+    Benchmark::verify_results();
+}
+
+// MultiQueue label-correcting SSSP (parallel_sssp.h) vs sequential Dijkstra
+// for 1, 2, 4, ... threads up to max_threads: time, stale pops and the share
+// of edge relaxations wasted on vertices scanned before their final distance
+void run_multiqueue_comparison(int max_threads) {
+    std::cout << "============================================================\n";
+    std::cout << "  Parallel SSSP on a MultiQueue (relaxed priority order)\n";
+    std::cout << "  (" << std::thread::hardware_concurrency() << " hardware threads, "
+              << "2 lanes per thread, 4-ary heap lanes)\n";
+    std::cout << "============================================================\n";
+
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(1000, 1000));
+    graphs.emplace_back("WorstCase", GraphGenerator::worst_case_graph(200000));
+    graphs.emplace_back("Dense", GraphGenerator::dense_random(2000));
+
+    for (const auto& [graph_type, g] : graphs) {
+        std::cout << "\n=== " << graph_type << " (V=" << g.size()
+                  << ", E=" << g.edge_count() << ") ===\n\n";
+
+        double ref_value = 0;
+        double seq_ms = best_of_3_ms([&] {
+            return Benchmark::distance_sum(dijkstra<BinaryHeap>(g, 0).dist);
+        }, ref_value);
+        std::cout << "Sequential Dijkstra (BinaryHeap): " << std::fixed << std::setprecision(3)
+                  << seq_ms << " ms\n\n";
+
+        std::cout << std::left << std::setw(9) << "Threads"
+                  << std::setw(7) << "Lanes"
+                  << std::setw(12) << "Time(ms)"
+                  << std::setw(9) << "Speedup"
+                  << std::setw(11) << "Pops"
+                  << std::setw(11) << "Stale"
+                  << std::setw(12) << "Relax"
+                  << std::setw(9) << "Wasted"
+                  << "Check\n";
+        std::cout << std::string(86, '-') << "\n";
+
+        for (int t = 1; t <= max_threads; t *= 2) {
+            ParallelSearchStats stats;
+            double value = 0;
+            double ms = best_of_3_ms([&] {
+                return Benchmark::distance_sum(parallel_sssp(g, 0, t, &stats).dist);
+            }, value);
+            std::cout << std::left << std::setw(9) << t
+                      << std::setw(7) << stats.lanes
+                      << std::fixed << std::setprecision(3) << std::setw(12) << ms
+                      << std::setprecision(2) << std::setw(9) << seq_ms / ms
+                      << std::setw(11) << stats.pops
+                      << std::setw(11) << stats.stale_pops
+                      << std::setw(12) << stats.relaxations
+                      << std::setw(9)
+                      << (std::to_string(100.0 * stats.wasted_fraction()).substr(0, 4) + "%")
+                      << (std::fabs(value - ref_value) < 1e-6 * std::max(1.0, ref_value) ? "ok" : "MISMATCH")
+                      << "\n";
+        }
+    }
+}
+
+// Incremental repair (dynamic_sssp.h) vs full Dijkstra after batches of
+// random weight changes to existing roads of a 1000 x 1000 grid: decreases
+// only, increases only, and mixed changes (the traffic-update case)
+void run_dynamic_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Incremental SSSP Repair vs Full Recompute (BinaryHeap)\n";
+    std::cout << "============================================================\n";
+
+    const Graph base = GraphGenerator::grid_graph(1000, 1000);
+    const int rounds = 3;
+    struct Kind {
+        const char* name;
+        double low, high; // new weight = old weight * U(low, high)
+    };
+
+    std::cout << "\nGrid (V=" << base.size() << ", E=" << base.edge_count() << "), source 0, "
+              << rounds << " batches per size\n\n";
+    std::cout << std::left << std::setw(10) << "Changes"
+              << std::setw(8) << "Batch"
+              << std::setw(12) << "Repair(ms)"
+              << std::setw(14) << "Recompute(ms)"
+              << std::setw(10) << "Speedup"
+              << std::setw(13) << "Invalidated"
+              << std::setw(11) << "Relabeled"
+              << "Check\n";
+    std::cout << std::string(84, '-') << "\n";
+
+    for (Kind kind : {Kind{"decrease", 0.5, 1.0}, Kind{"increase", 1.0, 2.0}, Kind{"mixed", 0.5, 2.0}}) {
+        Graph g = base;
+        DynamicSssp<BinaryHeap> dyn(g, 0);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> factor(kind.low, kind.high);
+
+        for (int batch : {1, 10, 100, 1000, 10000}) {
+            double repair_ms = 0, recompute_ms = 0;
+            std::size_t invalidated = 0, relabeled = 0;
+            bool ok = true;
+            for (int round = 0; round < rounds; round++) {
+                std::vector<EdgeUpdate> updates;
+                while (static_cast<int>(updates.size()) < batch) {
+                    int u = static_cast<int>(rng() % static_cast<unsigned>(g.size()));
+                    if (g.adj[u].empty()) continue;
+                    const Edge& e = g.adj[u][rng() % g.adj[u].size()];
+                    updates.push_back({u, e.to, e.weight * factor(rng)});
+                }
+                updates = both_directions(updates);
+
+                auto start = std::chrono::high_resolution_clock::now();
+                RepairStats stats = dyn.apply(updates);
+                auto mid = std::chrono::high_resolution_clock::now();
+                auto full = dijkstra<BinaryHeap>(g, 0);
+                auto end = std::chrono::high_resolution_clock::now();
+
+                repair_ms += std::chrono::duration<double, std::milli>(mid - start).count();
+                recompute_ms += std::chrono::duration<double, std::milli>(end - mid).count();
+                invalidated += stats.invalidated;
+                relabeled += stats.relabeled;
+                for (std::size_t v = 0; v < full.dist.size(); v++)
+                    if (std::fabs(full.dist[v] - dyn.result().dist[v]) > 1e-9 * std::max(1.0, full.dist[v]))
+                        ok = false;
+            }
+            std::cout << std::left << std::setw(10) << kind.name
+                      << std::setw(8) << batch
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << repair_ms / rounds
+                      << std::setw(14) << recompute_ms / rounds
+                      << std::setprecision(1) << std::setw(10) << recompute_ms / repair_ms
+                      << std::setw(13) << invalidated / rounds
+                      << std::setw(11) << relabeled / rounds
+                      << (ok ? "ok" : "MISMATCH") << "\n";
+        }
+    }
 }
 
-int main() {
+// Replay of a skewed query log against QueryService (query_service.h) with
+// the tree cache off and at several budgets: 90% of queries come from 300
+// popular sources (Zipf-distributed), the rest from random sources
+void run_query_service_replay() {
+    std::cout << "============================================================\n";
+    std::cout << "  Query Service: Shortest-Path-Tree Cache (LRU, float trees)\n";
+    std::cout << "============================================================\n";
+
+    const Graph g = GraphGenerator::grid_graph(120, 120);
+    const int num_queries = 4000;
+    const int popular = 300;
+
+    // Request log: (source, target, wants_path)
+    std::mt19937 rng(2024);
+    std::vector<int> hot(popular);
+    for (int& v : hot) v = static_cast<int>(rng() % static_cast<unsigned>(g.size()));
+    std::vector<double> zipf_cdf(popular);
+    double total = 0;
+    for (int i = 0; i < popular; i++) zipf_cdf[i] = (total += 1.0 / (i + 1));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    struct Request {
+        int source, target;
+        bool path;
+    };
+    std::vector<Request> log;
+    for (int q = 0; q < num_queries; q++) {
+        int source;
+        if (unit(rng) < 0.9) {
+            double x = unit(rng) * total;
+            source = hot[std::lower_bound(zipf_cdf.begin(), zipf_cdf.end(), x) - zipf_cdf.begin()];
+        } else {
+            source = static_cast<int>(rng() % static_cast<unsigned>(g.size()));
+        }
+        log.push_back({source, static_cast<int>(rng() % static_cast<unsigned>(g.size())),
+                       unit(rng) < 0.2});
+    }
+
+    std::cout << "\nGrid (V=" << g.size() << ", E=" << g.edge_count() << "), "
+              << num_queries << " queries (20% paths), " << popular << " popular sources\n\n";
+    std::cout << std::left << std::setw(12) << "Cache"
+              << std::setw(10) << "MB"
+              << std::setw(10) << "HitRate"
+              << std::setw(11) << "p50(us)"
+              << std::setw(11) << "p99(us)"
+              << std::setw(11) << "Mean(us)"
+              << std::setw(12) << "Queries/s"
+              << "Check\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    std::vector<double> reference; // uncached answers
+    for (std::size_t trees : {std::size_t(0), std::size_t(32), std::size_t(128), std::size_t(512)}) {
+        QueryService<BinaryHeap> service(g, trees * static_cast<std::size_t>(g.size()) * 8);
+        std::vector<double> answers;
+        answers.reserve(log.size());
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& r : log) {
+            if (r.path)
+                answers.push_back(static_cast<double>(service.path(r.source, r.target).size()));
+            else
+                answers.push_back(service.distance(r.source, r.target));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        bool ok = true;
+        if (reference.empty()) {
+            reference = answers;
+        } else {
+            for (std::size_t i = 0; i < answers.size(); i++)
+                if (std::fabs(answers[i] - reference[i]) > 1e-5 * std::max(1.0, reference[i]))
+                    ok = false;
+        }
+
+        const auto& lat = service.latency();
+        std::cout << std::left << std::setw(12)
+                  << (trees ? std::to_string(service.cache_capacity()) + " trees" : "off")
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(10) << service.cache_bytes() / 1e6
+                  << std::setprecision(3) << std::setw(10) << service.stats().hit_rate()
+                  << std::setprecision(1)
+                  << std::setw(11) << lat.percentile(50) / 1e3
+                  << std::setw(11) << lat.percentile(99) / 1e3
+                  << std::setw(11) << lat.mean() / 1e3
+                  << std::setprecision(0) << std::setw(12) << num_queries / seconds
+                  << (ok ? "ok" : "MISMATCH") << "\n";
+    }
+}
+
+// Doubling sweep per graph family until the time or memory budget is hit,
+// then complexity models (complexity_fit.h) fitted to the measured Dijkstra
+// times per heap and family, and to the decrease-key counts per heap. Each
+// family keeps its E / V ratio, so its times are fitted alone with
+// a*E + b*V*log V and extrapolated at that ratio; one model across families
+// can't absorb their different memory behaviour. Decrease-key counts don't
+// depend on the machine and are fitted jointly, where the families' E / V
+// ratios separate the E and V terms. Short runs are repeated and the median
+// kept; predictions are printed with the fit error.
+void run_scaling_study(double budget_seconds, double memory_mb) {
+    std::cout << "============================================================\n";
+    std::cout << "  Scaling Study: Doubling Sweep + Complexity Fits\n";
+    std::cout << "============================================================\n";
+
+    struct Family {
+        std::string name;
+        std::function<Graph(int)> make;
+    };
+    std::vector<Family> families = {
+        {"Sparse", [](int n) { return GraphGenerator::sparse_random_edges(n, 4); }},
+        {"Grid", [](int n) {
+             int side = static_cast<int>(std::lround(std::sqrt(static_cast<double>(n))));
+             return GraphGenerator::grid_graph(side, side);
+         }},
+        {"WorstCase", [](int n) { return GraphGenerator::worst_case_graph(n); }},
+    };
+    const std::vector<std::string> heaps = {BinaryHeap::name(), PairingHeap::name(), FibonacciHeap::name()};
+    // times[h][f]: heap h on family f
+    std::vector<std::vector<std::vector<ScalingSample>>> times(
+        heaps.size(), std::vector<std::vector<ScalingSample>>(families.size()));
+    std::vector<std::vector<ScalingSample>> decreases(heaps.size());
+    std::vector<double> edge_ratio(families.size(), 0); // E / V at each family's largest size
+    const double repeat_below_ms = 100;  // runs shorter than this are repeated...
+    const int max_repeats = 5;           // ...up to this many times, keeping the median
+    const std::size_t min_fit_sizes = 4; // two constants need a few more sizes to be checked
+    const double poor_fit_error = 0.15;  // predictions from a worse fit are flagged
+
+    // Median-time run; the first run decides whether repeating is worthwhile
+    auto median_run = [&](auto run, double& elapsed) {
+        std::vector<BenchmarkResult> runs = {run()};
+        while (static_cast<int>(runs.size()) < max_repeats && runs.front().total_time_ms < repeat_below_ms)
+            runs.push_back(run());
+        for (const auto& r : runs) elapsed += r.total_time_ms / 1e3;
+        std::sort(runs.begin(), runs.end(), [](const BenchmarkResult& a, const BenchmarkResult& b) {
+            return a.total_time_ms < b.total_time_ms;
+        });
+        return runs[runs.size() / 2];
+    };
+
+    std::cout << "\nBudget per family: " << budget_seconds << " s, " << memory_mb
+              << " MB of adjacency; eager Dijkstra from vertex 0, median of up to " << max_repeats
+              << " runs below " << repeat_below_ms << " ms\n\n";
+    std::cout << std::left << std::setw(11) << "Family" << std::setw(11) << "V"
+              << std::setw(12) << "E" << std::setw(9) << "MB" << std::setw(10) << "Gen(ms)";
+    for (const auto& h : heaps) std::cout << std::setw(15) << h;
+    std::cout << "\n" << std::string(98, '-') << "\n";
+
+    for (std::size_t f = 0; f < families.size(); f++) {
+        const Family& family = families[f];
+        double elapsed = 0, last_mb = 0;
+        for (int n = 1 << 12; n <= (1 << 26); n *= 2) {
+            if (elapsed > budget_seconds || 2 * last_mb > memory_mb) break;
+            auto start = std::chrono::high_resolution_clock::now();
+            Graph g = family.make(n);
+            auto end = std::chrono::high_resolution_clock::now();
+            double gen_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            last_mb = g.memory_bytes() / 1e6;
+
+            const double V = g.size(), E = static_cast<double>(g.edge_count());
+            elapsed += gen_ms / 1e3;
+            std::vector<BenchmarkResult> rows = {
+                median_run([&] { return Benchmark::run_dijkstra<BinaryHeap>(g, family.name); }, elapsed),
+                median_run([&] { return Benchmark::run_dijkstra<PairingHeap>(g, family.name); }, elapsed),
+                median_run([&] { return Benchmark::run_dijkstra<FibonacciHeap>(g, family.name); }, elapsed)};
+            std::cout << std::left << std::setw(11) << family.name << std::setw(11) << g.size()
+                      << std::setw(12) << g.edge_count() << std::fixed << std::setprecision(1)
+                      << std::setw(9) << last_mb << std::setw(10) << gen_ms;
+            for (std::size_t h = 0; h < rows.size(); h++) {
+                std::cout << std::setw(15) << rows[h].total_time_ms;
+                times[h][f].push_back({V, E, rows[h].total_time_ms * 1e6});
+                if (rows[h].decrease_key_ops > 0)
+                    decreases[h].push_back({V, E, static_cast<double>(rows[h].decrease_key_ops)});
+            }
+            std::cout << "\n" << std::flush;
+            edge_ratio[f] = E / V;
+        }
+    }
+
+    // The band is the fit's RMS relative error over the measured sizes; V=1e8
+    // is 10-1000x beyond them, so the true error there is likely larger
+    const double production_v = 1e8;
+    const ComplexityModel time_model = standard_models().front(); // a*E + b*V*log V
+    std::cout << "\nTime fits per family, t = " << time_model.name << " (log base 2, E/V as measured)\n"
+              << "a: ns per edge, b: ns per V*log V; predicted time at V=1e8 with the family's E/V, "
+              << "+/- RMS relative error of the fit\n\n";
+    std::cout << std::left << std::setw(11) << "Family" << std::setw(8) << "E/V" << std::setw(16) << "Heap"
+              << std::setw(12) << "a" << std::setw(12) << "b" << std::setw(9) << "Error" << "V=1e8 (s)\n";
+    std::cout << std::string(90, '-') << "\n";
+    for (std::size_t f = 0; f < families.size(); f++) {
+        for (std::size_t h = 0; h < heaps.size(); h++) {
+            const auto& samples = times[h][f];
+            std::cout << std::left << std::setw(11) << families[f].name << std::fixed << std::setprecision(1)
+                      << std::setw(8) << edge_ratio[f] << std::setw(16) << heaps[h];
+            if (samples.size() < min_fit_sizes) {
+                std::cout << "only " << samples.size() << " sizes measured; raise the budget for a fit\n";
+                continue;
+            }
+            ModelFit fit = fit_model(time_model, samples, true);
+            double predicted = fit.predict(production_v, production_v * edge_ratio[f]) / 1e9;
+            std::string error = std::to_string(std::lround(100 * fit.rms_rel_error)) + "%";
+            std::cout << std::setprecision(3) << std::setw(12) << fit.a << std::setw(12) << fit.b
+                      << std::setw(9) << error << std::setprecision(1);
+            if (predicted <= 0)
+                std::cout << "n/a (the fit turns negative)";
+            else
+                std::cout << predicted << " +/- " << error
+                          << (fit.rms_rel_error > poor_fit_error ? " (poor fit)" : "");
+            std::cout << "\n";
+        }
+    }
+
+    std::cout << "\nDecrease-key counts, a*E + b*V\n\n";
+    ComplexityModel linear = {"a*E + b*V", complexity_terms::e, complexity_terms::v};
+    for (std::size_t h = 0; h < heaps.size(); h++) {
+        if (decreases[h].empty()) continue;
+        ModelFit f = fit_model(linear, decreases[h]);
+        std::cout << std::left << std::setw(16) << heaps[h] << std::setprecision(4)
+                  << "a=" << std::setw(10) << f.a << "b=" << std::setw(10) << f.b
+                  << std::setprecision(1) << "error " << 100 * f.rms_rel_error << "%\n";
+    }
+}
+
+// Per-operation latency distributions (latency_histogram.h) for the main
+// heaps on graphs with few, many and bursty decrease-keys
+void run_latency_study() {
+    std::cout << "============================================================\n";
+    std::cout << "  Operation Latency: p50 / p99 / p99.9 / max per Heap\n";
+    std::cout << "============================================================\n";
+    std::cout << "Sampling 1 in " << latency::sample_every().load() << " operations (max is exact)\n";
+
+    struct Case {
+        std::string name;
+        Graph g;
+    };
+    std::vector<Case> cases;
+    cases.push_back({"Grid", GraphGenerator::grid_graph(700, 700)});
+    cases.push_back({"WorstCase", GraphGenerator::worst_case_graph(100000)});
+    cases.push_back({"Dense", GraphGenerator::dense_random(2000)});
+
+    for (const auto& c : cases) {
+        std::cout << "\n--- " << c.name << ": V=" << c.g.size() << ", E=" << c.g.edge_count() << " ---\n\n";
+        std::vector<BenchmarkResult> rows = {
+            Benchmark::run_dijkstra<BinaryHeap>(c.g, c.name),
+            Benchmark::run_dijkstra<PairingHeap>(c.g, c.name),
+            Benchmark::run_dijkstra<FibonacciHeap>(c.g, c.name),
+            Benchmark::run_dijkstra<RankPairingHeap2>(c.g, c.name),
+            Benchmark::run_dijkstra<HollowHeapMultiRoot>(c.g, c.name),
+        };
+        Benchmark::print_latency_header();
+        for (const auto& r : rows) Benchmark::print_latency(r);
+    }
+    Benchmark::verify_results();
+}
+
+// Heap shape telemetry (heap_shape.h) next to the timings: how long the
+// Fibonacci root list gets, how much cutting happens, how far pairing-heap
+// decrease-keys scan and how far binary-heap sifts travel, per graph family.
+// Timings come from a plain run; the telemetry run (the pairing heap's depth
+// walks are O(depth) per decrease-key) is only used for its counts.
+void run_shape_study() {
+    std::cout << "============================================================\n";
+    std::cout << "  Heap Shape Telemetry\n";
+    std::cout << "============================================================\n";
+
+    struct Case {
+        std::string name;
+        Graph g;
+    };
+    std::vector<Case> cases;
+    cases.push_back({"Grid", GraphGenerator::grid_graph(500, 500)});
+    cases.push_back({"Sparse", GraphGenerator::sparse_random_edges(200000, 4)});
+    cases.push_back({"WorstCase", GraphGenerator::worst_case_graph(50000)});
+    cases.push_back({"Dense", GraphGenerator::dense_random(2000)});
+
+    for (InsertMode mode : {InsertMode::Eager, InsertMode::Lazy}) {
+        std::cout << "\n======== " << (mode == InsertMode::Eager ? "Eager" : "Lazy")
+                  << " insertion ========\n";
+        for (const auto& c : cases) {
+            std::cout << "\n--- " << c.name << ": V=" << c.g.size() << ", E=" << c.g.edge_count() << " ---\n";
+            std::cout << std::left << std::setw(15) << "Heap" << std::setw(10) << "Time(ms)"
+                      << std::setw(12) << "ExtMin(ms)" << std::setw(12) << "DecKey(ms)" << "Shape\n";
+            std::cout << std::string(110, '-') << "\n";
+            auto timing = [](const BenchmarkResult& r) {
+                std::cout << std::left << std::setw(15) << r.heap_type << std::fixed << std::setprecision(1)
+                          << std::setw(10) << r.total_time_ms << std::setw(12) << r.extract_min_time_ms
+                          << std::setw(12) << r.decrease_key_time_ms;
+            };
+            auto avg_max = [](const ShapeCounter& s) {
+                std::ostringstream os;
+                os << std::fixed << std::setprecision(1) << s.mean() << " avg / " << s.max << " max";
+                return os.str();
+            };
+
+            FibonacciShapeStats fib;
+            timing(Benchmark::run_dijkstra<FibonacciHeap>(c.g, c.name, mode));
+            Benchmark::run_dijkstra_shape<FibonacciHeap>(c.g, c.name, fib, mode);
+            std::cout << "roots per consolidate " << avg_max(fib.root_list) << ", links " << fib.links
+                      << ", cuts " << fib.cuts << " + " << fib.cascading_cuts << " cascading"
+                      << ", max degree " << fib.max_degree << "\n";
+
+            PairingShapeStats pairing;
+            timing(Benchmark::run_dijkstra<PairingHeap>(c.g, c.name, mode));
+            Benchmark::run_dijkstra_shape<PairingHeap>(c.g, c.name, pairing, mode);
+            std::cout << "children at extract " << avg_max(pairing.children) << ", sibling scan "
+                      << avg_max(pairing.sibling_scan) << " (+" << pairing.leftmost_detaches
+                      << " unscanned), depth " << avg_max(pairing.depth) << "\n";
+
+            BinaryShapeStats binary;
+            timing(Benchmark::run_dijkstra<BinaryHeap>(c.g, c.name, mode));
+            Benchmark::run_dijkstra_shape<BinaryHeap>(c.g, c.name, binary, mode);
+            std::cout << "sift levels: insert " << avg_max(binary.insert_up) << ", decrease-key "
+                      << avg_max(binary.decrease_up) << ", extract " << avg_max(binary.extract_down) << "\n";
+        }
+    }
+    Benchmark::verify_results();
+}
+
+// Synthetic operation streams (heap_workload.h) against the three main heaps:
+// a (queue size x decrease-key ratio) grid, key distributions, stream lengths
+// up to max_ops, and the crossover points along each workload parameter
+void run_heap_workload_study(double max_ops) {
+    std::cout << "============================================================\n";
+    std::cout << "  Heap Workloads: Binary vs Pairing vs Fibonacci\n";
+    std::cout << "============================================================\n";
+
+    WorkloadSpec base;
+    base.operations = 1000000;
+    // Median of several rounds, each running every heap once; streams of
+    // 10^7+ operations average out most noise themselves, so they get fewer
+    auto all_three = [](const WorkloadSpec& spec) {
+        int rounds = spec.operations >= 100000000 ? 1 : spec.operations >= 10000000 ? 3 : 5;
+        std::vector<std::vector<double>> t(3);
+        for (int r = 0; r < rounds; r++) {
+            t[0].push_back(run_workload<BinaryHeap>(spec).ns_per_op);
+            t[1].push_back(run_workload<PairingHeap>(spec).ns_per_op);
+            t[2].push_back(run_workload<FibonacciHeap>(spec).ns_per_op);
+        }
+        return std::vector<double>{median_ns_per_op(t[0]), median_ns_per_op(t[1]), median_ns_per_op(t[2])};
+    };
+    const std::vector<std::string> names = {BinaryHeap::name(), PairingHeap::name(), FibonacciHeap::name()};
+    auto winner = [&](const std::vector<double>& t) {
+        return names[std::min_element(t.begin(), t.end()) - t.begin()];
+    };
+    auto header = [&](const std::string& first, const std::string& second) {
+        std::cout << std::left << std::setw(12) << first << std::setw(10) << second;
+        for (const auto& n : names) std::cout << std::setw(15) << n;
+        std::cout << "Fastest\n" << std::string(82, '-') << "\n";
+    };
+    auto cells = [&](const std::vector<double>& t) {
+        std::cout << std::fixed << std::setprecision(1);
+        for (double ns : t) std::cout << std::setw(15) << ns;
+        std::cout << winner(t) << "\n";
+    };
+
+    std::cout << "\nns per operation, median of 5 runs (3 at 10^7 operations, 1 at 10^8); "
+              << base.operations << " timed operations per cell, "
+              << "decrease_fraction " << base.decrease_fraction << ", uniform keys\n\n";
+    header("QueueSize", "DK/Ext");
+    const std::vector<double> ratios = {0.25, 1, 4, 16};
+    const std::vector<std::size_t> sizes = {1000, 10000, 100000, 1000000};
+    std::vector<std::vector<std::string>> rule(sizes.size());
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        for (double r : ratios) {
+            WorkloadSpec spec = base;
+            spec.queue_size = sizes[i];
+            spec.decrease_ratio = r;
+            std::vector<double> t = all_three(spec);
+            std::cout << std::left << std::setw(12) << sizes[i] << std::setprecision(2)
+                      << std::setw(10) << r;
+            cells(t);
+            rule[i].push_back(winner(t));
+        }
+    }
+
+    std::cout << "\n";
+    header("Keys", "");
+    for (KeyDistribution d : {KeyDistribution::Uniform, KeyDistribution::Exponential,
+                              KeyDistribution::Clustered}) {
+        WorkloadSpec spec = base;
+        spec.keys = d;
+        std::cout << std::left << std::setw(12) << key_distribution_name(d) << std::setw(10) << "";
+        cells(all_three(spec));
+    }
+
+    std::cout << "\n";
+    header("Operations", "");
+    for (double ops = 1e6; ops <= max_ops; ops *= 10) {
+        WorkloadSpec spec = base;
+        spec.operations = static_cast<std::uint64_t>(ops);
+        std::cout << std::left << std::setw(12) << std::scientific << std::setprecision(0) << ops
+                  << std::setw(10) << "";
+        cells(all_three(spec));
+    }
+
+    std::cout << "\nCrossovers (other parameters at queue_size " << base.queue_size
+              << ", DK/Ext " << base.decrease_ratio << ", decrease_fraction "
+              << base.decrease_fraction << ")\n"
+              << "Medians of 5 rounds; a side counts only if its heap won all 5 by 5% or more\n\n";
+    std::cout << std::left << std::setw(20) << "Parameter" << std::setw(30) << "Pair"
+              << "Crossover\n" << std::string(82, '-') << "\n";
+    WorkloadSpec search = base;
+    search.operations = 500000;
+    for (const WorkloadAxis& axis : default_workload_axes()) {
+        auto report = [&](const std::string& pair, const std::vector<Crossover>& found) {
+            std::cout << std::left << std::setw(20) << axis.name << std::setw(30) << pair;
+            if (found.empty()) std::cout << "none in [" << axis.lo << ", " << axis.hi << "]";
+            for (const auto& c : found)
+                std::cout << std::setprecision(3) << std::defaultfloat << c.faster_below << " below "
+                          << c.at << ", " << c.faster_above << " above  ";
+            std::cout << "\n";
+        };
+        report("Binary / Pairing", find_crossovers<BinaryHeap, PairingHeap>(search, axis));
+        report("Binary / Fibonacci", find_crossovers<BinaryHeap, FibonacciHeap>(search, axis));
+        report("Pairing / Fibonacci", find_crossovers<PairingHeap, FibonacciHeap>(search, axis));
+    }
+
+    std::cout << "\nRule: fastest heap by queue size (rows) and decrease-keys per extract (columns)\n\n";
+    std::cout << std::left << std::setw(12) << "";
+    for (double r : ratios) std::cout << std::setw(16) << std::defaultfloat << r;
+    std::cout << "\n";
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        std::cout << std::left << std::setw(12) << sizes[i];
+        for (const auto& w : rule[i]) std::cout << std::setw(16) << w;
+        std::cout << "\n";
+    }
+}
+
+// Memory and Dijkstra time of plain adjacency lists, CSR, and compressed
+// adjacency (compressed_graph.h) with exact and 16-bit quantized weights
+void run_compressed_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Compressed Adjacency: Delta + Varint Neighbour Lists\n";
+    std::cout << "============================================================\n";
+
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("Grid", GraphGenerator::grid_graph(1000, 1000));
+    Graph sparse = GraphGenerator::sparse_random(20000);
+    graphs.emplace_back("Sparse (RCM)", permute_graph(sparse, cuthill_mckee_order(sparse)));
+    graphs.emplace_back("Sparse", std::move(sparse));
+    graphs.emplace_back("Dense", GraphGenerator::dense_random(3000));
+
+    for (const auto& [graph_type, g] : graphs) {
+        std::cout << "\n=== " << graph_type << " (V=" << g.size() << ", E=" << g.edge_count()
+                  << "), lazy Dijkstra with a binary heap ===\n\n";
+        std::cout << std::left << std::setw(16) << "Storage"
+                  << std::setw(10) << "MB"
+                  << std::setw(10) << "B/edge"
+                  << std::setw(9) << "Ratio"
+                  << std::setw(11) << "Build(ms)"
+                  << std::setw(12) << "Search(ms)"
+                  << std::setw(10) << "Slowdown"
+                  << "Check\n";
+        std::cout << std::string(85, '-') << "\n";
+
+        const std::vector<double> reference = dijkstra<BinaryHeap>(g, 0, InsertMode::Lazy).dist;
+        const double edges = static_cast<double>(std::max<std::uint64_t>(1, g.edge_count()));
+        double base_bytes = 0, base_ms = 0;
+
+        // check: "ok" for exact distances, else the largest relative error
+        auto row = [&](const std::string& storage, const auto& graph, double build_ms) {
+            double result = 0;
+            std::vector<double> dist;
+            double ms = best_of_3_ms([&] {
+                dist = dijkstra<BinaryHeap>(graph, 0, InsertMode::Lazy).dist;
+                return 0.0;
+            }, result);
+            double bytes = static_cast<double>(graph.memory_bytes());
+            if (base_bytes == 0) {
+                base_bytes = bytes;
+                base_ms = ms;
+            }
+            double max_rel = 0;
+            bool exact = true;
+            for (std::size_t v = 0; v < dist.size(); v++) {
+                if (dist[v] == reference[v]) continue;
+                exact = false;
+                if (std::isinf(dist[v]) || std::isinf(reference[v])) max_rel = std::numeric_limits<double>::infinity();
+                else max_rel = std::max(max_rel, std::fabs(dist[v] - reference[v]) / reference[v]);
+            }
+            std::ostringstream check;
+            if (exact) check << "ok";
+            else check << "rel.err " << std::scientific << std::setprecision(1) << max_rel;
+            std::cout << std::left << std::setw(16) << storage << std::fixed << std::setprecision(1)
+                      << std::setw(10) << bytes / 1e6
+                      << std::setw(10) << bytes / edges
+                      << std::setprecision(2) << std::setw(9) << base_bytes / bytes
+                      << std::setprecision(1) << std::setw(11) << build_ms
+                      << std::setw(12) << ms
+                      << std::setprecision(2) << std::setw(10) << ms / base_ms
+                      << check.str() << "\n";
+        };
+        auto timed_build = [](auto build, double& ms) {
+            auto start = std::chrono::high_resolution_clock::now();
+            auto graph = build();
+            auto end = std::chrono::high_resolution_clock::now();
+            ms = std::chrono::duration<double, std::milli>(end - start).count();
+            return graph;
+        };
+
+        double build_ms = 0;
+        row("Graph", g, 0.0);
+        {
+            CsrGraph csr = timed_build([&] { return CsrGraph(g); }, build_ms);
+            row("CSR", csr, build_ms);
+        }
+        {
+            CompressedGraph cg = timed_build([&] { return CompressedGraph(g); }, build_ms);
+            row("Compressed", cg, build_ms);
+        }
+        {
+            QuantizedCompressedGraph qg = timed_build([&] { return QuantizedCompressedGraph(g); }, build_ms);
+            row("Compressed q16", qg, build_ms);
+        }
+    }
+}
+
+// Shortest paths on a shuffled 1500x1500 grid (random access across ~170 MB
+// of adjacency) with the CSR arrays and the queue under each MemoryPolicy
+// (page_memory.h); adjacency lists (Graph) are the baseline
+void run_memory_policy_comparison() {
+    std::cout << "============================================================\n";
+    std::cout << "  Memory Policy: Huge Pages and NUMA Placement\n";
+    std::cout << "============================================================\n";
+
+    using PagedHeap = BasicDaryHeap<4, double, int, PageAllocator>;
+    const int side = 1500;
+    Graph base = GraphGenerator::grid_graph(side, side);
+    const Graph g = permute_graph(base, shuffled_order(base));
+    base = Graph(0);
+    const int source = 0;
+    const std::vector<double> reference = dijkstra<BinaryHeap>(g, source, InsertMode::Lazy).dist;
+
+    bool have_counter = DtlbMissCounter().available();
+    std::cout << "\nShuffled grid (V=" << g.size() << ", E=" << g.edge_count()
+              << "), lazy Dijkstra with a 4-ary heap, NUMA nodes: "
+              << page_memory::numa_node_count() << "\n";
+    if (!have_counter)
+        std::cout << "(hardware dTLB counter unavailable; Misses column shows n/a)\n";
+    std::cout << "\n" << std::left << std::setw(10) << "Storage"
+              << std::setw(18) << "Policy"
+              << std::setw(11) << "Build(ms)"
+              << std::setw(12) << "Search(ms)"
+              << std::setw(14) << "dTLB misses"
+              << std::setw(10) << "HugeMB"
+              << "Check\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    auto row = [&](const std::string& storage, const std::string& policy, double build_ms,
+                   double search_ms, std::uint64_t misses, long long huge_bytes, bool ok) {
+        std::cout << std::left << std::setw(10) << storage << std::setw(18) << policy
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << build_ms << std::setw(12) << search_ms
+                  << std::setw(14) << (have_counter ? std::to_string(misses) : std::string("n/a"))
+                  << std::setw(10)
+                  << (huge_bytes < 0 ? std::string("n/a") : std::to_string(huge_bytes >> 20))
+                  << (ok ? "ok" : "MISMATCH") << "\n";
+    };
+
+    // Best of 3 searches; misses counted on the last one
+    auto measure = [&](auto&& search, double& ms, std::uint64_t& misses) {
+        DtlbMissCounter counter;
+        ms = std::numeric_limits<double>::infinity();
+        std::vector<double> dist;
+        for (int rep = 0; rep < 3; rep++) {
+            counter.start();
+            auto start = std::chrono::high_resolution_clock::now();
+            dist = search();
+            auto end = std::chrono::high_resolution_clock::now();
+            misses = counter.stop();
+            ms = std::min(ms, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return dist == reference;
+    };
+
+    {
+        double ms;
+        std::uint64_t misses = 0;
+        bool ok = measure([&] { return dijkstra_lazy<DaryHeap>(g, source).dist; }, ms, misses);
+        row("Graph", "vectors", 0.0, ms, misses, -1, ok);
+    }
+
+    std::vector<MemoryPolicy> policies = {
+        {PageMode::Small, NumaPlacement::FirstTouch, 0},
+        {PageMode::Small, NumaPlacement::Bind, 0},
+        {PageMode::Transparent, NumaPlacement::FirstTouch, 0},
+        {PageMode::Transparent, NumaPlacement::Interleave, 0},
+        {PageMode::Explicit, NumaPlacement::FirstTouch, 0},
+    };
+    const MemoryPolicy saved = page_memory::default_policy();
+    for (const MemoryPolicy& policy : policies) {
+        page_memory::default_policy() = policy; // queue storage
+        auto start = std::chrono::high_resolution_clock::now();
+        CsrGraph csr(g, policy);
+        auto end = std::chrono::high_resolution_clock::now();
+        double build_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        double ms;
+        std::uint64_t misses = 0;
+        bool ok = measure([&] { return dijkstra_lazy<PagedHeap>(csr, source).dist; }, ms, misses);
+        long long huge = page_memory::huge_page_bytes(csr.adj.edges.data(),
+                                                      csr.adj.edges.size() * sizeof(Edge));
+        row("CSR", policy.name(), build_ms, ms, misses, huge, ok);
+    }
+    page_memory::default_policy() = saved;
+
+    const auto& c = page_memory::counters();
+    if (c.explicit_fallbacks || c.placement_failures)
+        std::cout << "\n" << c.explicit_fallbacks << " HugeTLB allocation(s) fell back to THP "
+                  << "(reserve pages via /proc/sys/vm/nr_hugepages), "
+                  << c.placement_failures << " NUMA placement(s) rejected\n";
+}
+
+// Bounded queries (bounded_search.h) against a full search from the same
+// sources on a large grid; every answer is checked against the full result
+void run_bounded_queries() {
+    std::cout << "============================================================\n";
+    std::cout << "  Bounded Queries: k-Nearest / Radius / Target Set\n";
+    std::cout << "============================================================\n";
+
+    const Graph g = GraphGenerator::grid_graph(500, 500);
+    const int num_queries = 100;
+    const std::size_t k = 16;
+    const double radius = 1000.0;
+    const int num_facilities = 500;
+
+    std::mt19937 rng(7);
+    auto random_vertex = [&]() { return static_cast<int>(rng() % static_cast<unsigned>(g.size())); };
+    std::vector<int> sources(num_queries), facilities(num_facilities), targets(8);
+    for (int& v : sources) v = random_vertex();
+    for (int& v : facilities) v = random_vertex();
+    for (int& v : targets) v = random_vertex();
+
+    SearchWorkspace<BinaryHeap> ws(g.size());
+    std::vector<std::vector<double>> full(num_queries);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int q = 0; q < num_queries; q++) {
+        dijkstra(g, sources[q], ws);
+        full[q].assign(static_cast<std::size_t>(g.size()), infinite_weight<double>());
+        for (int v : ws.touched()) full[q][v] = ws.dist(v);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double full_us = std::chrono::duration<double, std::micro>(end - start).count() / num_queries;
+
+    std::cout << "\nGrid (V=" << g.size() << ", E=" << g.edge_count() << "), "
+              << num_queries << " sources, " << num_facilities << " facilities\n\n";
+    std::cout << std::left << std::setw(24) << "Query"
+              << std::setw(12) << "Settled"
+              << std::setw(12) << "Touched"
+              << std::setw(12) << "us/query"
+              << std::setw(10) << "Speedup"
+              << "Check\n";
+    std::cout << std::string(76, '-') << "\n";
+    std::cout << std::left << std::setw(24) << "full (workspace)"
+              << std::setw(12) << g.size() << std::setw(12) << g.size()
+              << std::fixed << std::setprecision(1) << std::setw(12) << full_us
+              << std::setw(10) << 1.0 << "-\n";
+
+    // One row per query kind; run returns the sparse result for source q
+    auto row = [&](const std::string& label, auto run, auto check) {
+        std::size_t settled = 0, touched = 0;
+        bool ok = true;
+        double us = 0; // queries only; the checks below are O(V)
+        for (int q = 0; q < num_queries; q++) {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            SparseResultFor<BinaryHeap> r = run(sources[q]);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            us += std::chrono::duration<double, std::micro>(t1 - t0).count() / num_queries;
+            settled += r.size();
+            touched += ws.touched().size();
+            for (std::size_t i = 0; i < r.size(); i++)
+                if (r.dist[i] != full[q][r.vertices[i]]) ok = false;
+            if (!check(q, r)) ok = false;
+        }
+        std::cout << std::left << std::setw(24) << label
+                  << std::setprecision(0) << std::setw(12) << double(settled) / num_queries
+                  << std::setw(12) << double(touched) / num_queries
+                  << std::setprecision(1) << std::setw(12) << us
+                  << std::setw(10) << full_us / us
+                  << (ok ? "ok" : "MISMATCH") << "\n";
+    };
+
+    // k-th settled distance must equal the k-th smallest full distance
+    row("k-nearest (k=" + std::to_string(k) + ")",
+        [&](int s) { return k_nearest(g, s, k, ws); },
+        [&](int q, const SparseResultFor<BinaryHeap>& r) {
+            std::vector<double> d = full[q];
+            std::nth_element(d.begin(), d.begin() + (k - 1), d.end());
+            return r.size() == k && r.dist.back() == d[k - 1];
+        });
+
+    row("radius (r=" + std::to_string(static_cast<int>(radius)) + ")",
+        [&](int s) { return within_radius(g, s, radius, ws); },
+        [&](int q, const SparseResultFor<BinaryHeap>& r) {
+            std::size_t expected = 0;
+            for (double d : full[q]) expected += d <= radius;
+            return r.size() == expected;
+        });
+
+    // The 3 closest facilities have the 3 smallest facility distances
+    row("nearest 3 facilities",
+        [&](int s) { return nearest_targets(g, s, facilities, 3, ws); },
+        [&](int q, const SparseResultFor<BinaryHeap>& r) {
+            std::vector<double> d;
+            for (int f : facilities) d.push_back(full[q][f]);
+            std::sort(d.begin(), d.end());
+            std::vector<int> found = settled_targets(r, facilities);
+            if (found.size() < 3) return false;
+            for (int i = 0; i < 3; i++)
+                if (full[q][found[i]] != d[i]) return false;
+            return true;
+        });
+
+    row("all of 8 targets",
+        [&](int s) { return to_targets(g, s, targets, ws); },
+        [&](int, const SparseResultFor<BinaryHeap>& r) {
+            return settled_targets(r, targets).size() == targets.size();
+        });
+}
+
+// Writes the trace file when main returns (--trace=FILE)
+struct TraceWriter {
+    std::string path;
+
+    ~TraceWriter() {
+        if (path.empty()) return;
+        trace::disable();
+        trace::Summary s = trace::summary();
+        if (!trace::write_chrome_json(path)) {
+            std::cerr << "Could not write trace to " << path << "\n";
+            return;
+        }
+        std::cout << "\nTrace: " << s.events << " events on " << s.threads << " thread(s)";
+        if (s.overwritten) std::cout << " (" << s.overwritten << " older events overwritten)";
+        std::cout << " written to " << path << " (open in ui.perfetto.dev)\n";
+    }
+};
+
+// Prints graph generation times when main returns, with load / store times
+// under --graph-cache; modes that generate no graph print nothing
+struct GraphCacheReport {
+    ~GraphCacheReport() { GraphCache::global().print_report(); }
+};
+
+int main(int argc, char* argv[]) {
+    // Executor flags for the full matrix; everything else is positional
+    //   --jobs=N        run N cells at a time (0 = one per CPU)
+    //   --processes     run each cell in a forked process instead of a thread
+    //   --pin           pin workers to CPUs
+    //   --one-per-core  one pinned worker per physical core (all cores unless --jobs)
+    //   --trace=FILE    record a Chrome trace-event timeline of any mode
+    //   --trace-sample=N  trace one in N heap operations (default 64)
+    //   --latency-sample=N  histogram one in N heap operations (default 1)
+    //   --graph-cache[=DIR]  load generated graphs from DIR (default graph_cache),
+    //                        storing the ones not there yet
+    ExecutorOptions exec_options;
+    TraceWriter trace_writer;
+    GraphCacheReport cache_report;
+    unsigned trace_sample = 64;
+    bool jobs_given = false;
+    std::vector<std::string> args;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--jobs=", 0) == 0) {
+            exec_options.jobs = std::atoi(arg.c_str() + 7);
+            jobs_given = true;
+        } else if (arg == "--processes") {
+            exec_options.isolation = Isolation::Processes;
+        } else if (arg == "--pin") {
+            exec_options.pin = true;
+        } else if (arg == "--one-per-core") {
+            exec_options.one_per_core = true;
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            trace_writer.path = arg.substr(8);
+        } else if (arg == "--graph-cache" || arg.rfind("--graph-cache=", 0) == 0) {
+            GraphCache::global().open(arg.size() > 14 ? arg.substr(14) : "graph_cache");
+        } else if (arg.rfind("--latency-sample=", 0) == 0) {
+            latency::sample_every().store(static_cast<unsigned>(std::max(1, std::atoi(arg.c_str() + 17))));
+        } else if (arg.rfind("--trace-sample=", 0) == 0) {
+            trace_sample = static_cast<unsigned>(std::max(1, std::atoi(arg.c_str() + 15)));
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (exec_options.one_per_core && !jobs_given) exec_options.jobs = 0;
+    if (!trace_writer.path.empty()) {
+        trace::enable(std::size_t(1) << 20, trace_sample);
+        trace::set_thread_name("main");
+    }
+
+    // Optional experiment selector; with no argument the full matrix runs
+    std::string mode = args.size() > 1 ? args[1] : "";
+    if (mode == "pairing") {
+        run_pairing_comparison();
+        return 0;
+    }
+    if (mode == "rank-pairing") {
+        run_rank_pairing_comparison();
+        return 0;
+    }
+    if (mode == "hollow") {
+        run_hollow_comparison();
+        return 0;
+    }
+    if (mode == "workspace") {
+        run_workspace_comparison();
+        return 0;
+    }
+    if (mode == "simd-relax") {
+        run_simd_relax_comparison();
+        return 0;
+    }
+    if (mode == "dense") {
+        run_dense_comparison();
+        return 0;
+    }
+    if (mode == "reorder") {
+        run_reorder_comparison();
+        return 0;
+    }
+    if (mode == "key-types") {
+        run_key_type_comparison();
+        return 0;
+    }
+    if (mode == "lazy-insert") {
+        run_lazy_insert_comparison();
+        return 0;
+    }
+    if (mode == "shape") {
+        run_shape_study();
+        return 0;
+    }
+    if (mode == "latency") {
+        run_latency_study();
+        return 0;
+    }
+    if (mode == "scaling") {
+        // Optional budgets, e.g. "./benchmark scaling 60 4000" (seconds per family, MB)
+        run_scaling_study(args.size() > 2 ? std::strtod(args[2].c_str(), nullptr) : 20.0,
+                          args.size() > 3 ? std::strtod(args[3].c_str(), nullptr) : 2000.0);
+        return 0;
+    }
+    if (mode == "heap-workload") {
+        // Optional longest stream, e.g. "./benchmark heap-workload 1e7"
+        run_heap_workload_study(args.size() > 2 ? std::strtod(args[2].c_str(), nullptr) : 1e8);
+        return 0;
+    }
+    if (mode == "compressed") {
+        run_compressed_comparison();
+        return 0;
+    }
+    if (mode == "memory-policy") {
+        run_memory_policy_comparison();
+        return 0;
+    }
+    if (mode == "bounded") {
+        run_bounded_queries();
+        return 0;
+    }
+    if (mode == "query-service") {
+        run_query_service_replay();
+        return 0;
+    }
+    if (mode == "dynamic") {
+        run_dynamic_comparison();
+        return 0;
+    }
+    if (mode == "multiqueue") {
+        // Optional thread limit, e.g. "./benchmark multiqueue 64"
+        int max_threads = args.size() > 2 ? std::atoi(args[2].c_str())
+                                   : static_cast<int>(std::thread::hardware_concurrency());
+        run_multiqueue_comparison(std::max(max_threads, 1));
+        return 0;
+    }
+    if (mode == "sequence-heap") {
+        // Optional upper bound on queue size, e.g. "./benchmark sequence-heap 1e6"
+        run_sequence_heap_sweep(args.size() > 2 ? std::strtod(args[2].c_str(), nullptr) : 1e8);
+        return 0;
+    }
+
     std::cout << "============================================================\n";
     std::cout << "  CS 470 - Priority Queue Comparative Analysis\n";
     std::cout << "  Dijkstra & Prim with Fibonacci / Pairing / Binary Heaps\n";
@@ -39,35 +1589,59 @@ int main() {
     // Graph sizes to test
     std::vector<int> sizes = {100, 500, 1000, 5000};
 
-    for (int n : sizes) {
-        std::cout << "\n\n############################################################\n";
-        std::cout << "  GRAPH SIZE: " << n << " vertices\n";
-        std::cout << "############################################################\n";
+    // Every (graph, algorithm, heap) cell is independent: generate the graphs,
+    // queue all cells, run them on the executor, then print per graph
+    struct ExperimentGroup {
+        int size;
+        std::string heading;
+        std::size_t first_cell;
+    };
+    BenchmarkExecutor exec(exec_options);
+    std::deque<Graph> graphs; // cells keep references, so no reallocation
+    std::vector<ExperimentGroup> groups;
+    auto add_graph = [&](int n, Graph g, const std::string& graph_type) {
+        graphs.push_back(std::move(g));
+        const Graph& stored = graphs.back();
+        groups.push_back({n, "=== " + graph_type + " (V=" + std::to_string(stored.size()) +
+                                 ", E=" + std::to_string(stored.edge_count()) + ") ===",
+                          exec.size()});
+        add_experiment(exec, stored, graph_type);
+    };
 
+    for (int n : sizes) {
         // 1. Sparse random graph (~4 edges per vertex)
-        {
-            auto g = GraphGenerator::sparse_random(n);
-            run_experiment(g, "Sparse");
-        }
+        add_graph(n, GraphGenerator::sparse_random(n), "Sparse");
 
         // 2. Dense random graph (~50% edge probability)
-        if (n <= 3000) {
-            auto g = GraphGenerator::dense_random(n);
-            run_experiment(g, "Dense");
-        }
+        if (n <= 3000)
+            add_graph(n, GraphGenerator::dense_random(n), "Dense");
 
         // 3. Grid graph (sqrt(n) x sqrt(n))
-        {
-            int side = static_cast<int>(std::sqrt(static_cast<double>(n)));
-            auto g = GraphGenerator::grid_graph(side, side);
-            run_experiment(g, "Grid");
-        }
+        int side = static_cast<int>(std::sqrt(static_cast<double>(n)));
+        add_graph(n, GraphGenerator::grid_graph(side, side), "Grid");
 
         // 4. Worst-case graph (forces many decrease-key operations)
-        {
-            auto g = GraphGenerator::worst_case_graph(n);
-            run_experiment(g, "WorstCase");
+        add_graph(n, GraphGenerator::worst_case_graph(n), "WorstCase");
+    }
+
+    std::cout << "\nRunning " << exec.size() << " cells on " << exec.workers()
+              << (exec.settings().isolation == Isolation::Processes
+                      ? (exec.workers() == 1 ? " process" : " processes")
+                      : (exec.workers() == 1 ? " thread" : " threads"))
+              << (exec.pinned() ? " (pinned)" : "") << "\n";
+    auto cell_results = exec.run();
+
+    for (std::size_t gi = 0; gi < groups.size(); gi++) {
+        if (gi == 0 || groups[gi].size != groups[gi - 1].size) {
+            std::cout << "\n\n############################################################\n";
+            std::cout << "  GRAPH SIZE: " << groups[gi].size << " vertices\n";
+            std::cout << "############################################################\n";
         }
+        std::cout << "\n" << groups[gi].heading << "\n\n";
+        Benchmark::print_header();
+        std::size_t end_cell = gi + 1 < groups.size() ? groups[gi + 1].first_cell : cell_results.size();
+        for (std::size_t c = groups[gi].first_cell; c < end_cell; c++)
+            Benchmark::print_result(cell_results[c]);
     }
 
     // Final consolidated output
@@ -81,6 +1655,7 @@ int main() {
 
     // Summary
     Benchmark::print_summary();
+    Benchmark::print_latency_summary();
 
     return 0;
 }